@@ -0,0 +1,160 @@
+#include "parallelworkdaycalendar.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+struct BenchmarkSettings
+{
+    uint32_t emulatedNodes = 0;
+    uint32_t queriesPerBatch = 1 << 20;
+    uint32_t rounds = 20;
+};
+
+bool parseArguments(int argc, char **argv, BenchmarkSettings &settings);
+WorkdayCalendar makeCalendar(void);
+double measureThroughput(ParallelWorkdayCalendar &calendar,
+                         const std::vector<PackedDateTime> &startDates,
+                         const std::vector<float> &increments,
+                         uint32_t rounds);
+} // namespace
+
+int main(int argc, char **argv)
+{
+    BenchmarkSettings settings{};
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " [emulated nodes, 0 reads sysfs] [queries per batch] [rounds]\n";
+        return 1;
+    }
+
+    std::vector<NumaNode> topology = readNumaTopology();
+    if (settings.emulatedNodes > 0)
+    {
+        topology = emulateNumaTopology(topology, settings.emulatedNodes);
+    }
+
+    WorkdayCalendar calendar = makeCalendar();
+    std::mt19937 random{39};
+    std::uniform_int_distribution<PackedDateTime> startDates{
+        packDateTime({Date{year{1975}, January, day{1}}, {}}),
+        packDateTime({Date{year{2095}, December, day{31}}, {}})};
+    std::uniform_real_distribution<float> increments{-50.0f, 50.0f};
+    std::vector<PackedDateTime> starts(settings.queriesPerBatch);
+    std::vector<float> steps(settings.queriesPerBatch);
+    for (uint32_t i = 0; i < settings.queriesPerBatch; ++i)
+    {
+        starts[i] = startDates(random);
+        steps[i] = increments(random);
+    }
+
+    std::cout << topology.size() << (settings.emulatedNodes > 0 ? " emulated" : "")
+              << " node(s), " << settings.queriesPerBatch << " queries per batch, "
+              << settings.rounds << " rounds\n"
+              << "nodes  workers     shared q/s   per-node q/s  per-node gain\n";
+
+    // Grow the machine one node at a time, so remote nodes join in one after the other
+    for (size_t n = 1; n <= topology.size(); ++n)
+    {
+        std::vector<NumaNode> nodes{topology.begin(), topology.begin() + static_cast<long>(n)};
+        ParallelWorkdayCalendar shared{calendar, nodes, ReplicaPlacement::Shared};
+        double sharedThroughput = measureThroughput(shared, starts, steps, settings.rounds);
+        ParallelWorkdayCalendar perNode{calendar, nodes, ReplicaPlacement::PerNode};
+        double perNodeThroughput = measureThroughput(perNode, starts, steps, settings.rounds);
+
+        std::cout << std::setw(5) << n << std::setw(9) << perNode.getNumberOfWorkers()
+                  << std::fixed << std::setprecision(0) << std::setw(15) << sharedThroughput
+                  << std::setw(15) << perNodeThroughput << std::setprecision(2)
+                  << std::setw(14) << perNodeThroughput / sharedThroughput << "x\n";
+    }
+
+    return 0;
+}
+
+namespace
+{
+bool parseArguments(int argc, char **argv, BenchmarkSettings &settings)
+{
+    uint32_t *optional[] = {
+        &settings.emulatedNodes, &settings.queriesPerBatch, &settings.rounds};
+    for (int i = 1; i < argc; ++i)
+    {
+        if (i - 1 >= 3)
+        {
+            return false;
+        }
+        unsigned long value = 0;
+        try
+        {
+            value = std::stoul(argv[i]);
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        if (value > UINT32_MAX)
+        {
+            return false;
+        }
+        *optional[i - 1] = static_cast<uint32_t>(value);
+    }
+
+    return (settings.queriesPerBatch > 0) && (settings.rounds > 0);
+}
+
+WorkdayCalendar makeCalendar(void)
+{
+    WorkdayCalendar result{};
+    result.setWorkdayStartAndStop(GregorianCalendar{2000, January, 1, 8, 0},
+                                  GregorianCalendar{2000, January, 1, 16, 0});
+
+    std::vector<Date> recurring{Date{year{2000}, January, day{1}},
+                                Date{year{2000}, May, day{1}},
+                                Date{year{2000}, May, day{17}},
+                                Date{year{2000}, December, day{25}},
+                                Date{year{2000}, December, day{26}}};
+    result.setRecurringHolidays(recurring);
+
+    // A few movable holidays every year, as a real site calendar would have
+    std::vector<Date> holidays{};
+    for (int y = 1970; y <= 2100; ++y)
+    {
+        sys_days march = sys_days{year{y} / March / 1};
+        for (int offset : {20, 23, 24, 60, 70})
+        {
+            holidays.push_back(Date{march + days{offset + y % 7}});
+        }
+    }
+    result.setHolidays(holidays);
+
+    result.buildIndex(Date{year{1970}, January, day{1}}, Date{year{2100}, December, day{31}});
+    return result;
+}
+
+double measureThroughput(ParallelWorkdayCalendar &calendar,
+                         const std::vector<PackedDateTime> &startDates,
+                         const std::vector<float> &increments,
+                         uint32_t rounds)
+{
+    std::vector<PackedDateTime> results(startDates.size());
+    calendar.getWorkdayIncrements(startDates, increments, results, BatchOrder::Unsorted);
+
+    auto start = steady_clock::now();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        calendar.getWorkdayIncrements(startDates, increments, results, BatchOrder::Unsorted);
+    }
+    auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start);
+
+    return static_cast<double>(startDates.size()) * rounds / elapsed.count();
+}
+} // namespace
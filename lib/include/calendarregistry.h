@@ -0,0 +1,46 @@
+#pragma once
+#include "commoncalendar.h"
+#include "holidayset.h"
+#include "workdaycalendar.h"
+#include "workdayindex.h"
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief Interns holiday sets and their compiled index across many calendars
+ *
+ * Calendars returned by intern() point to one shared HolidaySet and one
+ * shared WorkdayIndex per distinct set of holidays. Holidays added afterwards
+ * are kept as a per-calendar delta and the index is copied on first write,
+ * so tenants which only differ in a few days only pay for those days.
+ *
+ * Copy-on-write decides from the shared index's use count, which is only a
+ * hint while other threads copy calendars. Calendars of one registry must
+ * not be changed while other threads read or copy any of them.
+ *
+ */
+class CalendarRegistry
+{
+  public:
+    CalendarRegistry(Date firstDay, Date lastDay);
+
+    CalendarRegistry(void) = delete;
+
+    ~CalendarRegistry(void) = default;
+
+    WorkdayCalendar intern(const WorkdayCalendar &calendar);
+
+    size_t getNumberOfHolidaySets(void) const;
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<const HolidaySet> holidays;
+        std::shared_ptr<WorkdayIndex> index;
+    };
+
+    Date firstDay_{};
+    Date lastDay_{};
+    std::unordered_multimap<size_t, Entry> entries_{};
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 
 using Month = std::chrono::month;
 using Date = std::chrono::year_month_day;
@@ -10,3 +11,19 @@ struct DateTime
     Date date;
     Time time;
 };
+
+// Minutes since 1970-01-01 00:00, the flat form of a DateTime used by the bulk APIs
+using PackedDateTime = int64_t;
+
+inline PackedDateTime packDateTime(DateTime dt)
+{
+    auto tp = std::chrono::sys_days(dt.date) + dt.time.hours() + dt.time.minutes();
+    return tp.time_since_epoch().count();
+}
+
+inline DateTime unpackDateTime(PackedDateTime packed)
+{
+    std::chrono::sys_time<std::chrono::minutes> tp{std::chrono::minutes{packed}};
+    auto d = std::chrono::floor<std::chrono::days>(tp);
+    return {Date{d}, Time{tp - d}};
+}
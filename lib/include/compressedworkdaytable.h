@@ -0,0 +1,63 @@
+#pragma once
+#include "commoncalendar.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Working-day table stored as rules instead of one bit per day
+ *
+ * A weekly pattern, the recurring holidays and the sorted non-recurring
+ * holidays describe every day of the proleptic Gregorian calendar in a few
+ * hundred bytes. The calendar repeats itself every 400 years, so shared
+ * tables of weekday counts over that cycle place every recurring holiday in
+ * closed form. Counting a range is constant time plus a binary search over
+ * the exceptions and finding the n-th working day bisects on that count.
+ *
+ */
+class CompressedWorkdayTable
+{
+  public:
+    // Bit 0 is Monday, bit 6 is Sunday
+    static constexpr uint8_t mondayToFriday = 0x1F;
+
+    CompressedWorkdayTable(uint8_t weeklyPattern,
+                           std::span<const Date> recurringHolidays,
+                           std::span<const Date> holidays);
+
+    CompressedWorkdayTable(void) = delete;
+
+    ~CompressedWorkdayTable(void) = default;
+
+    bool contains(std::chrono::sys_days day) const;
+
+    bool isWorkday(std::chrono::sys_days day) const;
+
+    uint32_t countWorkdays(std::chrono::sys_days from, std::chrono::sys_days to) const;
+
+    std::optional<std::chrono::sys_days> findWorkday(std::chrono::sys_days from,
+                                                     int32_t workdays) const;
+
+    size_t getMemoryUsage(void) const;
+
+  private:
+    struct RecurringHoliday
+    {
+        Month month;
+        std::chrono::day day;
+        uint8_t reference;
+        uint8_t workingWeekdays;
+    };
+
+    struct YearCache;
+
+    int64_t countBefore(std::chrono::sys_days day, YearCache &cache) const;
+    bool isPatternWorkday(std::chrono::sys_days day) const;
+    bool isRecurringHoliday(Date date) const;
+
+    uint8_t weeklyPattern_{};
+    std::vector<RecurringHoliday> recurring_{};
+    std::vector<int32_t> exceptions_{};
+};
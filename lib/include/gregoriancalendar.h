@@ -1,6 +1,8 @@
 #pragma once
 #include "commoncalendar.h"
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 /**
  * @brief Class which represents a time point
@@ -36,3 +38,28 @@ class GregorianCalendar
     std::chrono::year_month_day date_{};
     std::chrono::hh_mm_ss<std::chrono::minutes> time_{};
 };
+
+/**
+ * @brief Raw calendar fields of many time points, one array per field
+ *
+ */
+struct DateTimeFields
+{
+    std::span<const int16_t> years;
+    std::span<const uint8_t> months;
+    std::span<const uint8_t> days;
+    std::span<const uint8_t> hours;
+    std::span<const uint8_t> minutes;
+};
+
+/**
+ * @brief Bulk form of the GregorianCalendar constructor
+ *
+ * Clamps every time point exactly like GregorianCalendar does and writes it
+ * packed to results. Bit i of invalidMask[i / 64] is set when the raw fields
+ * of time point i needed clamping. Returns the number of invalid inputs.
+ *
+ */
+size_t packDateTimes(const DateTimeFields &fields,
+                     std::span<PackedDateTime> results,
+                     std::span<uint64_t> invalidMask);
@@ -0,0 +1,31 @@
+#pragma once
+#include "workdaycalendar.h"
+#include <cstddef>
+#include <string_view>
+
+struct HolidayImportResult
+{
+    size_t holidays;
+    size_t recurringHolidays;
+    size_t skipped;
+};
+
+/**
+ * @brief Streams the VEVENTs of an iCalendar buffer into the calendar
+ *
+ * Date-valued DTSTART/DTEND spans become holidays. An open-ended yearly RRULE
+ * becomes a recurring holiday, a bounded one (COUNT/UNTIL) is expanded into
+ * plain holidays. BYMONTH/BYMONTHDAY may restate the date of DTSTART, events
+ * with any other rule are skipped. Folded lines are unfolded first.
+ *
+ */
+HolidayImportResult importIcsHolidays(std::string_view buffer, WorkdayCalendar &calendar);
+
+/**
+ * @brief Streams a CSV buffer whose first column is a date into the calendar
+ *
+ * "YYYY-MM-DD" and "YYYYMMDD" are holidays, "--MM-DD" and "MM-DD" are
+ * recurring holidays. Other lines, such as a header, are skipped.
+ *
+ */
+HolidayImportResult importCsvHolidays(std::string_view buffer, WorkdayCalendar &calendar);
@@ -0,0 +1,23 @@
+#pragma once
+#include "commoncalendar.h"
+#include <span>
+#include <vector>
+
+/**
+ * @brief Immutable, normalized holiday lists which calendars can share
+ *
+ * Both lists are sorted and free of duplicates. Recurring holidays are
+ * stored in year 0 (a leap year) so that only month and day compare.
+ *
+ */
+struct HolidaySet
+{
+    std::vector<Date> nonRecurring;
+    std::vector<Date> recurring;
+
+    bool operator==(const HolidaySet &) const = default;
+};
+
+HolidaySet makeHolidaySet(std::span<const Date> nonRecurring, std::span<const Date> recurring);
+
+bool isHoliday(const HolidaySet &holidays, Date date);
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One memory node and the CPUs this process may run on there
+ *
+ */
+struct NumaNode
+{
+    uint32_t id;
+    std::vector<uint32_t> cpus;
+};
+
+/**
+ * @brief Reads the NUMA nodes from sysfs, without libnuma
+ *
+ * Parses <root>/node<N>/cpulist and keeps the CPUs of the process affinity
+ * mask. Nodes without such CPUs, memory-only nodes for instance, are left
+ * out. Without sysfs the whole machine is one node.
+ *
+ */
+std::vector<NumaNode> readNumaTopology(const std::string &root = "/sys/devices/system/node");
+
+/**
+ * @brief Splits the CPUs of a topology into evenly sized pretend nodes
+ *
+ * Lets the replicated query path be exercised on single-node machines.
+ *
+ */
+std::vector<NumaNode> emulateNumaTopology(const std::vector<NumaNode> &topology,
+                                          uint32_t numberOfNodes);
+
+/**
+ * @brief Restricts the calling thread to the CPUs of one node
+ *
+ * Memory first written by the thread afterwards is then placed on that node
+ * by the kernel's first-touch policy. Returns false when the affinity could
+ * not be set, always on platforms other than Linux.
+ *
+ */
+bool pinCurrentThread(const NumaNode &node);
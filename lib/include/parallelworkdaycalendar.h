@@ -0,0 +1,79 @@
+#pragma once
+#include "commoncalendar.h"
+#include "numatopology.h"
+#include "workdaycalendar.h"
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+enum class ReplicaPlacement
+{
+    Shared,
+    PerNode
+};
+
+/**
+ * @brief Splits batch queries of a frozen calendar across pinned workers
+ *
+ * One worker is pinned to every CPU of the topology. With PerNode placement
+ * each node gets its own deep copy of the calendar, built by a thread pinned
+ * to that node so first-touch places its tables in local memory, and workers
+ * only read the replica of their node. Shared placement keeps one copy for
+ * everyone, as a baseline. Later changes to the source calendar are not seen.
+ *
+ */
+class ParallelWorkdayCalendar
+{
+  public:
+    ParallelWorkdayCalendar(const WorkdayCalendar &calendar,
+                            std::vector<NumaNode> topology = readNumaTopology(),
+                            ReplicaPlacement placement = ReplicaPlacement::PerNode);
+
+    ParallelWorkdayCalendar(void) = delete;
+
+    ParallelWorkdayCalendar(const ParallelWorkdayCalendar &) = delete;
+
+    ParallelWorkdayCalendar &operator=(const ParallelWorkdayCalendar &) = delete;
+
+    ~ParallelWorkdayCalendar(void);
+
+    // Rethrows the first exception of any worker once all of them are done
+    void getWorkdayIncrements(std::span<const PackedDateTime> startDates,
+                              std::span<const float> incrementWorkdays,
+                              std::span<PackedDateTime> results,
+                              BatchOrder order = BatchOrder::Detect);
+
+    size_t getNumberOfReplicas(void) const;
+
+    size_t getNumberOfWorkers(void) const;
+
+  private:
+    struct Batch
+    {
+        std::span<const PackedDateTime> startDates;
+        std::span<const float> incrementWorkdays;
+        std::span<PackedDateTime> results;
+        BatchOrder order;
+    };
+
+    void stopWorkers(void);
+    void runWorker(size_t worker, const NumaNode &place, WorkdayCalendar &replica);
+
+    std::vector<std::unique_ptr<WorkdayCalendar>> replicas_{};
+    std::vector<std::thread> workers_{};
+    size_t numberOfWorkers_ = 0;
+    std::mutex queryMutex_{};
+    std::mutex mutex_{};
+    std::condition_variable wake_{};
+    std::condition_variable done_{};
+    Batch batch_{};
+    std::exception_ptr error_{};
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool isStopping_ = false;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include "commoncalendar.h"
+#include "workdaybitmap.h"
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Half-open range [start, stop) of packed timestamps
+struct WorkingInterval
+{
+    PackedDateTime start;
+    PackedDateTime stop;
+};
+
+/**
+ * @brief Working minutes over sets of intervals, as used by SLA clocks
+ *
+ * A running count of working minutes is kept per 64-day word of the
+ * compiled bitmap, so the working time up to any timestamp is one lookup,
+ * one popcount and a clamp of the time of day into the working hours. The
+ * working time of an interval is the difference of two such counts. Time
+ * outside the bitmap's days is not counted.
+ *
+ */
+class SlaClock
+{
+  public:
+    SlaClock(WorkdayBitmap bitmap, Time startWorkday, Time stopWorkday);
+
+    SlaClock(void) = delete;
+
+    ~SlaClock(void) = default;
+
+    std::chrono::minutes getWorkingTime(WorkingInterval interval) const;
+
+    /*
+     * Working time covered by any of the open intervals and none of the
+     * pauses. Neither list needs to be sorted or free of overlaps.
+     */
+    std::chrono::minutes getWorkingTime(std::span<const WorkingInterval> open,
+                                        std::span<const WorkingInterval> paused) const;
+
+    /*
+     * Batch over many entities in compressed rows: the open intervals of
+     * entity i are open[openOffsets[i], openOffsets[i + 1]) and likewise for
+     * the pauses, so both offset lists hold one entry more than results.
+     * Throws std::invalid_argument unless each offset list is ascending and
+     * ends at the size of its interval list.
+     */
+    void getWorkingTimes(std::span<const WorkingInterval> open,
+                         std::span<const uint32_t> openOffsets,
+                         std::span<const WorkingInterval> paused,
+                         std::span<const uint32_t> pausedOffsets,
+                         std::span<std::chrono::minutes> results) const;
+
+  private:
+    int64_t getWorkingMinutesUpTo(PackedDateTime timestamp) const;
+    std::chrono::minutes subtractPauses(std::span<const WorkingInterval> open,
+                                        std::span<const WorkingInterval> paused) const;
+
+    WorkdayBitmap bitmap_;
+    std::vector<int64_t> workdaysBeforeWord_{};
+    int64_t firstDay_{};
+    int64_t numberOfDays_{};
+    int64_t startMinute_{};
+    int64_t stopMinute_{};
+};
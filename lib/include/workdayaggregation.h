@@ -0,0 +1,40 @@
+#pragma once
+#include "commoncalendar.h"
+#include "workdaycalendar.h"
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+enum class AggregationPeriod
+{
+    PerWeek,
+    PerMonth,
+    PerQuarter,
+    PerYear
+};
+
+/**
+ * @brief Working days and working time inside one period bucket
+ *
+ * Buckets are clipped to the requested range, so the first and last
+ * bucket may start later or end earlier than the calendar period.
+ *
+ */
+struct PeriodWorkload
+{
+    Date periodStart;
+    uint32_t workdays;
+    std::chrono::minutes workingTime;
+};
+
+std::vector<PeriodWorkload> aggregateWorkload(const WorkdayCalendar &calendar,
+                                              Date firstDay,
+                                              Date lastDay,
+                                              AggregationPeriod period);
+
+std::vector<std::vector<PeriodWorkload>> aggregateWorkload(
+    std::span<const WorkdayCalendar> calendars,
+    Date firstDay,
+    Date lastDay,
+    AggregationPeriod period);
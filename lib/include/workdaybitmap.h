@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Compiled working-day table of a calendar over a closed range of days
+ *
+ * Each day of the range is one bit, set when the day is a working day.
+ * Counting working days over a sub-range is a popcount over the words.
+ *
+ */
+class WorkdayBitmap
+{
+  public:
+    static constexpr int64_t daysPerWord = 64;
+
+    WorkdayBitmap(std::chrono::sys_days firstDay, std::chrono::sys_days lastDay);
+
+    WorkdayBitmap(void) = delete;
+
+    ~WorkdayBitmap(void) = default;
+
+    std::chrono::sys_days getFirstDay(void) const;
+
+    std::chrono::sys_days getLastDay(void) const;
+
+    bool contains(std::chrono::sys_days day) const;
+
+    bool isWorkday(std::chrono::sys_days day) const;
+
+    void setWorkday(std::chrono::sys_days day, bool isWorking);
+
+    uint32_t countWorkdays(std::chrono::sys_days from, std::chrono::sys_days to) const;
+
+    std::span<const uint64_t> getWords(void) const;
+
+  private:
+    std::chrono::sys_days firstDay_{};
+    std::chrono::sys_days lastDay_{};
+    std::vector<uint64_t> words_{};
+};
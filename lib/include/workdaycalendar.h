@@ -1,8 +1,35 @@
 #pragma once
 #include "commoncalendar.h"
+#include "compressedworkdaytable.h"
 #include "gregoriancalendar.h"
+#include "holidayset.h"
+#include "slaclock.h"
+#include "workdaybitmap.h"
+#include "workdayindex.h"
+#include "zonetransitiontable.h"
+#include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 
+// Largest increment entry points taking untrusted input accept, about 3800 years of workdays
+constexpr float maxIncrementWorkdays = 1.0e6f;
+
+enum class BatchOrder
+{
+    Unsorted,
+    Sorted,
+    Detect
+};
+
+/**
+ * @brief Adds fractional workdays to dates given working hours and holidays
+ *
+ * Copies and calendars interned by one CalendarRegistry share their index,
+ * so none of them may be changed while another thread reads or copies any
+ * of them.
+ *
+ */
 class WorkdayCalendar
 {
   public:
@@ -14,13 +41,71 @@ class WorkdayCalendar
 
     void setRecurringHoliday(GregorianCalendar date);
 
+    void setHolidays(std::span<const Date> dates);
+
+    void setRecurringHolidays(std::span<const Date> dates);
+
+    void removeHoliday(GregorianCalendar date);
+
+    void removeRecurringHoliday(GregorianCalendar date);
+
     void setWorkdayStartAndStop(GregorianCalendar startTime, GregorianCalendar stopTime);
 
     DateTime getWorkdayIncrement(DateTime startDate, float incrementWorkdays);
 
+    void getWorkdayIncrements(std::span<const PackedDateTime> startDates,
+                              std::span<const float> incrementWorkdays,
+                              std::span<PackedDateTime> results,
+                              BatchOrder order = BatchOrder::Detect);
+
+    void classifyWorkingTime(std::span<const PackedDateTime> timestamps,
+                             std::span<uint64_t> workingMask) const;
+
+    void setTimeZone(std::shared_ptr<const ZoneTransitionTable> zone);
+
+    PackedDateTime getUtcWorkdayIncrement(PackedDateTime utcStartDate, float incrementWorkdays);
+
+    void getUtcWorkdayIncrements(std::span<const PackedDateTime> utcStartDates,
+                                 std::span<const float> incrementWorkdays,
+                                 std::span<PackedDateTime> utcResults,
+                                 BatchOrder order = BatchOrder::Detect);
+
+    std::chrono::minutes getWorkdayLength(void) const;
+
+    WorkdayBitmap compile(Date firstDay, Date lastDay) const;
+
+    void buildIndex(Date firstDay, Date lastDay);
+
+    CompressedWorkdayTable compress(void) const;
+
+    void buildCompressedTable(void);
+
+    SlaClock makeSlaClock(Date firstDay, Date lastDay) const;
+
+    HolidaySet getHolidays(void) const;
+
+    WorkdayCalendar replicate(void) const;
+
   private:
+    friend class CalendarRegistry;
+
+    void shareHolidays(std::shared_ptr<const HolidaySet> holidays,
+                       std::shared_ptr<WorkdayIndex> index);
+    void detachSharedHolidays(void);
+    WorkdayIndex &getMutableIndex(void);
+    bool isHolidayFree(void) const;
+    void refreshIndex(Date date, bool isRecurring);
+    void markIndexedHoliday(Date date, bool isRecurring);
+    void refreshCompressedTable(void);
+    std::pair<std::chrono::year, std::chrono::year> getIndexedYears(Date date,
+                                                                    bool isRecurring) const;
+
     Time start_{};
     Time stop_{};
     std::vector<Date> nonRecurringHolidays_{};
     std::vector<Date> recurringHolidays_{};
+    std::shared_ptr<const HolidaySet> sharedHolidays_{};
+    std::shared_ptr<WorkdayIndex> index_{};
+    std::shared_ptr<const CompressedWorkdayTable> compressed_{};
+    std::shared_ptr<const ZoneTransitionTable> zone_{};
 };
@@ -0,0 +1,124 @@
+#ifndef WORKDAYCALENDARC_H
+#define WORKDAYCALENDARC_H
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Stable C interface of the workday calendar, built as the workdaycalendarc
+ * shared library. Only C types cross the boundary and no exception escapes.
+ *
+ * Timestamps are packed: minutes since 1970-01-01 00:00 as int64_t. Dates
+ * are days since 1970-01-01 as int32_t; recurring holidays only use their
+ * month and day. Bulk calls work on caller-owned arrays of count elements
+ * and never copy them; results may alias the start timestamps.
+ *
+ * A calendar is built with the setters, then frozen. Freezing compiles the
+ * day index for a year window, rejects further changes and makes concurrent
+ * queries on the same handle safe.
+ */
+
+#if defined(_WIN32)
+#if defined(WORKDAYCALENDAR_C_EXPORTS)
+#define WORKDAYCALENDAR_C_API __declspec(dllexport)
+#else
+#define WORKDAYCALENDAR_C_API __declspec(dllimport)
+#endif
+#else
+#define WORKDAYCALENDAR_C_API __attribute__((visibility("default")))
+#endif
+
+#define WORKDAYCALENDAR_C_ABI_VERSION 1
+
+/* Largest increment magnitude accepted by the increment calls */
+#define WORKDAYCALENDAR_C_MAX_INCREMENT_WORKDAYS 1000000.0f
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct WorkdayCalendarHandle WorkdayCalendarHandle;
+
+typedef enum WorkdayCalendarStatus
+{
+    WorkdayCalendarOk = 0,
+    WorkdayCalendarInvalidArgument = 1,
+    WorkdayCalendarFrozen = 2,
+    WorkdayCalendarOutOfMemory = 3,
+    WorkdayCalendarInternalError = 4
+} WorkdayCalendarStatus;
+
+WORKDAYCALENDAR_C_API uint32_t workdayCalendarAbiVersion(void);
+
+/* Returns NULL when out of memory, release with workdayCalendarDestroy */
+WORKDAYCALENDAR_C_API WorkdayCalendarHandle *workdayCalendarCreate(void);
+
+WORKDAYCALENDAR_C_API void workdayCalendarDestroy(WorkdayCalendarHandle *calendar);
+
+/* Working hours as minutes of the day, 0 <= start < stop < 1440 */
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarSetWorkingHours(WorkdayCalendarHandle *calendar,
+                               uint32_t startMinute,
+                               uint32_t stopMinute);
+
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarAddHolidays(WorkdayCalendarHandle *calendar,
+                           const int32_t *daysSinceEpoch,
+                           size_t count);
+
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarAddRecurringHolidays(WorkdayCalendarHandle *calendar,
+                                    const int32_t *daysSinceEpoch,
+                                    size_t count);
+
+/*
+ * Offsets are local time minus UTC in minutes. transitionTimestamps[i] is
+ * the first UTC minute of transitionOffsets[i]; initialOffset applies
+ * before the first transition. Used by workdayCalendarUtcIncrements.
+ */
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarSetTimeZone(WorkdayCalendarHandle *calendar,
+                           int32_t initialOffset,
+                           const int64_t *transitionTimestamps,
+                           const int32_t *transitionOffsets,
+                           size_t count);
+
+/* Compiles the index for [firstYear, lastYear], the calendar is read-only afterwards */
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus workdayCalendarFreeze(WorkdayCalendarHandle *calendar,
+                                                                  int32_t firstYear,
+                                                                  int32_t lastYear);
+
+/*
+ * Fails with WorkdayCalendarInvalidArgument, leaving results untouched, when
+ * any increment is NaN, infinite or larger in magnitude than
+ * WORKDAYCALENDAR_C_MAX_INCREMENT_WORKDAYS.
+ */
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarIncrements(WorkdayCalendarHandle *calendar,
+                          const int64_t *startTimestamps,
+                          const float *incrementWorkdays,
+                          int64_t *results,
+                          size_t count);
+
+/* Same as workdayCalendarIncrements with UTC timestamps in and out */
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarUtcIncrements(WorkdayCalendarHandle *calendar,
+                             const int64_t *startTimestamps,
+                             const float *incrementWorkdays,
+                             int64_t *results,
+                             size_t count);
+
+/* Bit i of workingMask[i / 64] is set when timestamps[i] is working time, the mask
+ * holds (count + 63) / 64 words. Timestamps are local wall-clock time: the zone of
+ * workdayCalendarSetTimeZone is not applied, convert UTC input before calling */
+WORKDAYCALENDAR_C_API WorkdayCalendarStatus
+workdayCalendarClassifyWorkingTime(const WorkdayCalendarHandle *calendar,
+                                   const int64_t *timestamps,
+                                   uint64_t *workingMask,
+                                   size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+#include "workdaybitmap.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Working-day bitmap with an incrementally maintained count index
+ *
+ * A Fenwick tree over the popcount of every 64-day word keeps prefix counts
+ * up to date, so toggling one day, counting a range and finding the n-th
+ * working day from a given day are all O(log n).
+ *
+ */
+class WorkdayIndex
+{
+  public:
+    explicit WorkdayIndex(WorkdayBitmap bitmap);
+
+    WorkdayIndex(void) = delete;
+
+    ~WorkdayIndex(void) = default;
+
+    bool contains(std::chrono::sys_days day) const;
+
+    bool isWorkday(std::chrono::sys_days day) const;
+
+    void setWorkday(std::chrono::sys_days day, bool isWorking);
+
+    uint32_t countWorkdays(std::chrono::sys_days from, std::chrono::sys_days to) const;
+
+    std::optional<std::chrono::sys_days> findWorkday(std::chrono::sys_days from,
+                                                     int32_t workdays) const;
+
+    const WorkdayBitmap &getBitmap(void) const;
+
+  private:
+    uint32_t countUpTo(std::chrono::sys_days day) const;
+    uint32_t prefixOfWords(size_t numberOfWords) const;
+    void addToWord(size_t word, int32_t delta);
+    std::optional<std::chrono::sys_days> findNthWorkday(uint32_t n) const;
+
+    WorkdayBitmap bitmap_;
+    std::vector<uint32_t> tree_{};
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include "commoncalendar.h"
+#include "workdaybitmap.h"
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Flags which packed timestamps fall inside working time
+ *
+ * A timestamp is working time when its day is a working day in the bitmap
+ * and its time of day is in [startWorkday, stopWorkday). Bit i of
+ * workingMask[i / 64] receives the flag of timestamps[i]; days outside the
+ * bitmap count as non-working. Uses AVX2 when the CPU supports it.
+ *
+ */
+void classifyWorkingTime(const WorkdayBitmap &bitmap,
+                         Time startWorkday,
+                         Time stopWorkday,
+                         std::span<const PackedDateTime> timestamps,
+                         std::span<uint64_t> workingMask);
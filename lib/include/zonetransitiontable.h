@@ -0,0 +1,73 @@
+#pragma once
+#include "commoncalendar.h"
+#include <chrono>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_chrono) && (__cpp_lib_chrono >= 201907L)
+#define WORKDAYCALENDAR_HAS_TZDB 1
+#endif
+
+struct OffsetTransition
+{
+    PackedDateTime utc;          // First UTC minute of the new offset
+    std::chrono::minutes offset; // Local time minus UTC from then on
+};
+
+/**
+ * @brief UTC offsets of one time zone as a sorted transition table
+ *
+ * Converting between UTC and local packed timestamps is a binary search
+ * over the transitions. The first offset extends before the first
+ * transition and the last one after the last transition. Local times that
+ * occur twice resolve to the earlier instant, local times skipped by a
+ * forward jump are moved forward by the size of the jump.
+ *
+ */
+class ZoneTransitionTable
+{
+  public:
+    ZoneTransitionTable(std::chrono::minutes initialOffset,
+                        std::span<const OffsetTransition> transitions);
+
+    ZoneTransitionTable(void) = delete;
+
+    ~ZoneTransitionTable(void) = default;
+
+    std::chrono::minutes getOffset(PackedDateTime utc) const;
+
+    PackedDateTime toLocal(PackedDateTime utc) const;
+
+    PackedDateTime toUtc(PackedDateTime local) const;
+
+    void toLocal(std::span<PackedDateTime> timestamps) const;
+
+    void toUtc(std::span<PackedDateTime> timestamps) const;
+
+#ifdef WORKDAYCALENDAR_HAS_TZDB
+    static ZoneTransitionTable fromTimeZone(const std::chrono::time_zone &zone,
+                                            std::chrono::year firstYear,
+                                            std::chrono::year lastYear);
+#endif
+
+  private:
+    std::vector<PackedDateTime> utcTransitions_{};
+    std::vector<PackedDateTime> localTransitions_{};
+    std::vector<std::chrono::minutes> offsets_{};
+};
+
+#ifdef WORKDAYCALENDAR_HAS_TZDB
+/**
+ * @brief Transition table of a tzdb zone over [firstYear, lastYear]
+ *
+ * Tables are built once per zone and window and shared by every caller.
+ * Returns an empty pointer when the zone is not in the local tzdb.
+ *
+ */
+std::shared_ptr<const ZoneTransitionTable> getZoneTransitionTable(std::string_view zoneName,
+                                                                  std::chrono::year firstYear,
+                                                                  std::chrono::year lastYear);
+#endif
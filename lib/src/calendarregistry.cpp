@@ -0,0 +1,71 @@
+#include "calendarregistry.h"
+#include <functional>
+#include <initializer_list>
+
+using namespace std::chrono;
+
+namespace
+{
+size_t hashHolidays(const HolidaySet &holidays);
+} // namespace
+
+CalendarRegistry::CalendarRegistry(Date firstDay, Date lastDay)
+    : firstDay_(firstDay), lastDay_(lastDay)
+{
+}
+
+WorkdayCalendar CalendarRegistry::intern(const WorkdayCalendar &calendar)
+{
+    HolidaySet holidays = calendar.getHolidays();
+    size_t hash = hashHolidays(holidays);
+
+    const Entry *entry = nullptr;
+    auto [first, last] = entries_.equal_range(hash);
+    for (auto it = first; it != last; ++it)
+    {
+        if (*it->second.holidays == holidays)
+        {
+            entry = &it->second;
+            break;
+        }
+    }
+
+    if (!entry)
+    {
+        auto shared = std::make_shared<const HolidaySet>(std::move(holidays));
+        WorkdayCalendar prototype{};
+        prototype.shareHolidays(shared, nullptr);
+        auto index = std::make_shared<WorkdayIndex>(prototype.compile(firstDay_, lastDay_));
+        entry = &entries_.emplace(hash, Entry{.holidays = shared, .index = index})->second;
+    }
+
+    // Working hours stay per calendar, only the day tables are shared
+    WorkdayCalendar result = calendar;
+    result.shareHolidays(entry->holidays, entry->index);
+
+    return result;
+}
+
+size_t CalendarRegistry::getNumberOfHolidaySets(void) const
+{
+    return entries_.size();
+}
+
+namespace
+{
+size_t hashHolidays(const HolidaySet &holidays)
+{
+    size_t result = holidays.nonRecurring.size() * 31 + holidays.recurring.size();
+    for (const std::vector<Date> *list : {&holidays.nonRecurring, &holidays.recurring})
+    {
+        for (Date date : *list)
+        {
+            size_t value = static_cast<size_t>(sys_days{date}.time_since_epoch().count());
+            result ^= std::hash<size_t>{}(value) + 0x9e3779b9u + (result << 6)
+                      + (result >> 2);
+        }
+    }
+
+    return result;
+}
+} // namespace
@@ -0,0 +1,332 @@
+#include "compressedworkdaytable.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+using namespace std::chrono;
+
+namespace
+{
+// 400 Gregorian years are exactly 20871 weeks, so the weekday of a month and day repeats
+constexpr int32_t yearsPerCycle = 400;
+constexpr sys_days mondayBeforeEpoch{days{-3}};
+constexpr int64_t searchLimit = int64_t{1} << 22;
+
+/*
+ * A recurring holiday keeps a fixed distance to January 1 when it falls in
+ * January or February and to March 1 otherwise, February 29 only exists in
+ * leap years. For each of these reference days the table counts the years of
+ * the cycle below a given year whose reference day is a given weekday.
+ */
+enum Reference : uint8_t
+{
+    JanuaryFirst,
+    MarchFirst,
+    LeapMarchFirst,
+    NumberOfReferences
+};
+
+using YearsBefore = std::array<std::array<std::array<uint16_t, 8>, yearsPerCycle + 1>,
+                               NumberOfReferences>;
+
+const YearsBefore &getYearsBefore(void);
+int64_t floorDivide(int64_t value, int64_t divisor);
+uint32_t getWeekdayIndex(sys_days day);
+int32_t toDayNumber(sys_days day);
+} // namespace
+
+/*
+ * Recurring holidays of the years before a day only depend on its year, and
+ * the days looked at by one query rarely span more than a year or two.
+ */
+struct CompressedWorkdayTable::YearCache
+{
+    year cachedYear{year::min()};
+    int64_t recurringBefore{};
+    std::array<uint32_t, NumberOfReferences> referenceWeekdays{};
+};
+
+CompressedWorkdayTable::CompressedWorkdayTable(uint8_t weeklyPattern,
+                                               std::span<const Date> recurringHolidays,
+                                               std::span<const Date> holidays)
+    : weeklyPattern_(weeklyPattern & 0x7F)
+{
+    for (Date holiday : recurringHolidays)
+    {
+        // Year 2000 is a leap year, so every month and day that can ever occur is valid there
+        Date sample{year{2000}, holiday.month(), holiday.day()};
+        if (!sample.ok() || isRecurringHoliday(sample))
+        {
+            continue;
+        }
+
+        bool isLeapDay = (sample.month() == February) && (sample.day() == day{29});
+        RecurringHoliday recurring{.month = sample.month(),
+                                   .day = sample.day(),
+                                   .reference = isLeapDay                    ? LeapMarchFirst
+                                                : (sample.month() > February) ? MarchFirst
+                                                                              : JanuaryFirst,
+                                   .workingWeekdays = 0};
+        Date reference{year{2000}, (recurring.reference == JanuaryFirst) ? January : March, day{1}};
+
+        int64_t distance = (sys_days{sample} - sys_days{reference}).count();
+        for (uint32_t w = 0; w < 7; ++w)
+        {
+            int64_t landsOn = (w + distance % 7 + 7) % 7;
+            if ((weeklyPattern_ >> landsOn) & 1u)
+            {
+                recurring.workingWeekdays |= static_cast<uint8_t>(1u << w);
+            }
+        }
+        if (recurring.workingWeekdays)
+        {
+            recurring_.push_back(recurring);
+        }
+    }
+
+    std::sort(recurring_.begin(), recurring_.end(), [](const auto &lhs, const auto &rhs) {
+        return (lhs.month < rhs.month) || ((lhs.month == rhs.month) && (lhs.day < rhs.day));
+    });
+
+    // Holidays already off through the pattern or a recurring holiday need no exception
+    for (Date holiday : holidays)
+    {
+        if (holiday.ok() && isPatternWorkday(sys_days{holiday}) && !isRecurringHoliday(holiday))
+        {
+            exceptions_.push_back(toDayNumber(sys_days{holiday}));
+        }
+    }
+    std::sort(exceptions_.begin(), exceptions_.end());
+    exceptions_.erase(std::unique(exceptions_.begin(), exceptions_.end()), exceptions_.end());
+
+    recurring_.shrink_to_fit();
+    exceptions_.shrink_to_fit();
+}
+
+bool CompressedWorkdayTable::contains(sys_days) const
+{
+    return true;
+}
+
+bool CompressedWorkdayTable::isWorkday(sys_days day) const
+{
+    return isPatternWorkday(day) && !isRecurringHoliday(Date{day})
+           && !std::binary_search(exceptions_.begin(), exceptions_.end(), toDayNumber(day));
+}
+
+uint32_t CompressedWorkdayTable::countWorkdays(sys_days from, sys_days to) const
+{
+    if (from > to)
+    {
+        return 0;
+    }
+
+    YearCache cache{};
+    return static_cast<uint32_t>(countBefore(to + days{1}, cache) - countBefore(from, cache));
+}
+
+std::optional<sys_days> CompressedWorkdayTable::findWorkday(sys_days from, int32_t workdays) const
+{
+    int32_t workingWeekdays = std::popcount(weeklyPattern_);
+    if (workingWeekdays == 0)
+    {
+        return std::nullopt;
+    }
+
+    // The wanted day is the first one whose running count reaches the target
+    YearCache cache{};
+    int64_t target = (workdays >= 0) ? countBefore(from + days{1}, cache) + workdays
+                                     : countBefore(from, cache) + workdays + 1;
+    auto reaches = [this, target, &cache](sys_days day) {
+        return countBefore(day + days{1}, cache) >= target;
+    };
+
+    // Correct the pattern's estimate by the working days it is still off, holidays only
+    // make it fall short by a few. Once the count matches, the answer is the last working
+    // day up to the estimate.
+    sys_days estimate = from + days{int64_t{workdays} * 7 / workingWeekdays};
+    for (int32_t corrections = 0; corrections < 4; ++corrections)
+    {
+        int64_t missing = target - countBefore(estimate + days{1}, cache);
+        if (missing == 0)
+        {
+            for (sys_days candidate = estimate; candidate > estimate - weeks{1}; --candidate)
+            {
+                if (isWorkday(candidate))
+                {
+                    return candidate;
+                }
+            }
+            break;
+        }
+        estimate += days{missing * 7 / workingWeekdays + ((missing > 0) ? 1 : -1)};
+    }
+
+    // Otherwise widen a bracket around the estimate until it holds the answer and bisect it
+
+    sys_days low = estimate;
+    sys_days high = estimate;
+    int64_t step = 1;
+    if (reaches(estimate))
+    {
+        while (reaches(low))
+        {
+            if (step > searchLimit)
+            {
+                return std::nullopt;
+            }
+            high = low;
+            low -= days{step};
+            step *= 2;
+        }
+    }
+    else
+    {
+        while (!reaches(high))
+        {
+            if (step > searchLimit)
+            {
+                return std::nullopt;
+            }
+            low = high;
+            high += days{step};
+            step *= 2;
+        }
+    }
+
+    while (high - low > days{1})
+    {
+        sys_days middle = low + (high - low) / 2;
+        if (reaches(middle))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle;
+        }
+    }
+
+    return high;
+}
+
+size_t CompressedWorkdayTable::getMemoryUsage(void) const
+{
+    return sizeof(*this) + recurring_.capacity() * sizeof(RecurringHoliday)
+           + exceptions_.capacity() * sizeof(int32_t);
+}
+
+int64_t CompressedWorkdayTable::countBefore(sys_days day, YearCache &cache) const
+{
+    // Working days of the weekly pattern from an arbitrary Monday, negative before it
+    int64_t offset = (day - mondayBeforeEpoch).count();
+    int64_t weeks = floorDivide(offset, 7);
+    uint32_t partialWeek = weeklyPattern_ & ((1u << (offset - weeks * 7)) - 1u);
+    int64_t result = weeks * std::popcount(weeklyPattern_) + std::popcount(partialWeek);
+
+    Date date{day};
+    if (date.year() != cache.cachedYear)
+    {
+        int64_t cycles = floorDivide(static_cast<int32_t>(date.year()), yearsPerCycle);
+        size_t yearInCycle
+            = static_cast<size_t>(static_cast<int32_t>(date.year()) - cycles * yearsPerCycle);
+        const YearsBefore &yearsBefore = getYearsBefore();
+
+        cache.cachedYear = date.year();
+        cache.recurringBefore = 0;
+        for (const RecurringHoliday &holiday : recurring_)
+        {
+            const auto &perCycle = yearsBefore[holiday.reference][yearsPerCycle];
+            const auto &beforeYear = yearsBefore[holiday.reference][yearInCycle];
+            for (uint32_t weekdays = holiday.workingWeekdays; weekdays; weekdays &= weekdays - 1)
+            {
+                size_t w = static_cast<size_t>(std::countr_zero(weekdays));
+                cache.recurringBefore += cycles * perCycle[w] + beforeYear[w];
+            }
+        }
+
+        // A weekday index of 7 matches no holiday, February 29 is missing in common years
+        uint32_t januaryFirst = getWeekdayIndex(sys_days{date.year() / January / 1});
+        uint32_t marchFirst = getWeekdayIndex(sys_days{date.year() / March / 1});
+        cache.referenceWeekdays[JanuaryFirst] = januaryFirst;
+        cache.referenceWeekdays[MarchFirst] = marchFirst;
+        cache.referenceWeekdays[LeapMarchFirst] = date.year().is_leap() ? marchFirst : 7u;
+    }
+    result -= cache.recurringBefore;
+
+    // Sorted by month and day, so only the holidays earlier in the year are visited
+    for (const RecurringHoliday &holiday : recurring_)
+    {
+        if ((holiday.month > date.month())
+            || ((holiday.month == date.month()) && (holiday.day >= date.day())))
+        {
+            break;
+        }
+        uint32_t referenceWeekday = cache.referenceWeekdays[holiday.reference];
+        result -= (holiday.workingWeekdays >> referenceWeekday) & 1u;
+    }
+
+    auto exceptions = std::lower_bound(exceptions_.begin(), exceptions_.end(), toDayNumber(day));
+    result -= exceptions - exceptions_.begin();
+
+    return result;
+}
+
+bool CompressedWorkdayTable::isPatternWorkday(sys_days day) const
+{
+    return (weeklyPattern_ >> getWeekdayIndex(day)) & 1u;
+}
+
+bool CompressedWorkdayTable::isRecurringHoliday(Date date) const
+{
+    return date.ok()
+           && std::any_of(recurring_.begin(), recurring_.end(), [date](const auto &holiday) {
+                  return (holiday.month == date.month()) && (holiday.day == date.day());
+              });
+}
+
+namespace
+{
+const YearsBefore &getYearsBefore(void)
+{
+    static const YearsBefore result = [] {
+        YearsBefore table{};
+        for (int32_t y = 0; y < yearsPerCycle; ++y)
+        {
+            uint32_t januaryFirst = getWeekdayIndex(sys_days{Date{year{y}, January, day{1}}});
+            uint32_t marchFirst = getWeekdayIndex(sys_days{Date{year{y}, March, day{1}}});
+            bool isLeap = year{y}.is_leap();
+            std::array<bool, NumberOfReferences> isReference{};
+            size_t current = static_cast<size_t>(y);
+            for (size_t w = 0; w < 7; ++w)
+            {
+                isReference = {januaryFirst == w, marchFirst == w, isLeap && (marchFirst == w)};
+                for (size_t reference = 0; reference < NumberOfReferences; ++reference)
+                {
+                    table[reference][current + 1][w] = static_cast<uint16_t>(
+                        table[reference][current][w] + isReference[reference]);
+                }
+            }
+        }
+        return table;
+    }();
+
+    return result;
+}
+
+uint32_t getWeekdayIndex(sys_days day)
+{
+    return weekday{day}.iso_encoding() - 1;
+}
+
+int64_t floorDivide(int64_t value, int64_t divisor)
+{
+    int64_t quotient = value / divisor;
+    return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+
+int32_t toDayNumber(sys_days day)
+{
+    return static_cast<int32_t>(day.time_since_epoch().count());
+}
+} // namespace
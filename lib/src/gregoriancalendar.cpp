@@ -1,12 +1,69 @@
 #include "gregoriancalendar.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define WORKDAYCALENDAR_HAS_AVX2_KERNEL 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WORKDAYCALENDAR_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define WORKDAYCALENDAR_ALWAYS_INLINE inline
+#endif
 
 using namespace std::chrono;
 
 namespace
 {
+// Indexed by (is leap << 8) | month, covering every value a std::chrono::month can hold
+using DaysInMonthTable = std::array<uint32_t, 512>;
+
+// Keeps the year positive for any int16_t, a whole number of 400 year cycles
+constexpr uint32_t yearBias = 82 * 400;
+constexpr int32_t daysBeforeEpoch = 719468 + 82 * 146097;
+constexpr size_t blockSize = 64;
+
+constexpr DaysInMonthTable daysInMonth = [] {
+    /*
+     * Source: https://github.com/cassioneri/calendar
+     */
+
+    DaysInMonthTable table{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        table[i] = static_cast<uint8_t>(30 | (i ^ (i >> 3)));
+        table[256 | i] = table[i];
+    }
+    table[2] = 28;
+    table[256 | 2] = 29;
+
+    return table;
+}();
+
 uint8_t getNumberOfDaysInMonth(year, Month);
 year_month_day clamp(year_month_day, Month);
 hh_mm_ss<minutes> clamp(hh_mm_ss<minutes>);
+uint32_t isLeapYear(uint32_t biasedYear);
+void packRange(const DateTimeFields &fields,
+               size_t first,
+               size_t count,
+               PackedDateTime *results,
+               uint8_t *isInvalid);
+void packBlock(const DateTimeFields &fields,
+               size_t first,
+               size_t count,
+               PackedDateTime *results,
+               uint8_t *isInvalid);
+
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+__attribute__((target("avx2"))) void packBlockAvx2(const DateTimeFields &fields,
+                                                   size_t first,
+                                                   size_t count,
+                                                   PackedDateTime *results,
+                                                   uint8_t *isInvalid);
+#endif
 } // namespace
 
 GregorianCalendar::GregorianCalendar(DateTime dt) : date_(dt.date), time_(dt.time)
@@ -41,21 +98,56 @@ Date GregorianCalendar::getDate(void)
     return date_;
 }
 
-namespace
-{
-uint8_t getNumberOfDaysInMonth(year y, Month m)
+size_t packDateTimes(const DateTimeFields &fields,
+                     std::span<PackedDateTime> results,
+                     std::span<uint64_t> invalidMask)
 {
-    /*
-     * Source: https://github.com/cassioneri/calendar
-     */
+    size_t count = std::min({fields.years.size(),
+                             fields.months.size(),
+                             fields.days.size(),
+                             fields.hours.size(),
+                             fields.minutes.size(),
+                             results.size(),
+                             invalidMask.size() * 64});
+
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+    bool hasAvx2 = __builtin_cpu_supports("avx2");
+#endif
 
-    if (m == February)
+    size_t numberOfInvalid = 0;
+    for (size_t first = 0; first < count; first += blockSize)
     {
-        return y.is_leap() ? 29 : 28;
+        size_t length = std::min(blockSize, count - first);
+        uint8_t isInvalid[blockSize] = {};
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+        if (hasAvx2)
+        {
+            packBlockAvx2(fields, first, length, results.data(), isInvalid);
+        }
+        else
+#endif
+        {
+            packBlock(fields, first, length, results.data(), isInvalid);
+        }
+
+        uint64_t word = 0;
+        for (size_t i = 0; i < blockSize; ++i)
+        {
+            word |= static_cast<uint64_t>(isInvalid[i]) << i;
+        }
+        invalidMask[first / blockSize] = word;
+        numberOfInvalid += static_cast<size_t>(std::popcount(word));
     }
 
-    unsigned int i = static_cast<unsigned int>(m);
-    return static_cast<uint8_t>(30 | (i ^ (i >> 3)));
+    return numberOfInvalid;
+}
+
+namespace
+{
+uint8_t getNumberOfDaysInMonth(year y, Month m)
+{
+    return static_cast<uint8_t>(
+        daysInMonth[(static_cast<uint32_t>(y.is_leap()) << 8) | static_cast<unsigned int>(m)]);
 }
 
 year_month_day clamp(year_month_day date, Month month)
@@ -89,4 +181,76 @@ hh_mm_ss<minutes> clamp(hh_mm_ss<minutes> time)
 
     return time;
 }
+
+uint32_t isLeapYear(uint32_t biasedYear)
+{
+    return static_cast<uint32_t>((biasedYear % 4 == 0) & (biasedYear % 100 != 0))
+         | static_cast<uint32_t>(biasedYear % 400 == 0);
+}
+
+// Same rules as the clamp() pair above, written as selects so the loop vectorizes
+WORKDAYCALENDAR_ALWAYS_INLINE void packRange(const DateTimeFields &fields,
+                                             size_t first,
+                                             size_t count,
+                                             PackedDateTime *results,
+                                             uint8_t *isInvalid)
+{
+    const int16_t *years = fields.years.data() + first;
+    const uint8_t *months = fields.months.data() + first;
+    const uint8_t *days = fields.days.data() + first;
+    const uint8_t *hours = fields.hours.data() + first;
+    const uint8_t *minutes = fields.minutes.data() + first;
+    results += first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t y = static_cast<uint32_t>(years[i] + static_cast<int32_t>(yearBias));
+        uint32_t m = months[i];
+        uint32_t d = days[i];
+        uint32_t minuteOfDay = hours[i] * 60u + minutes[i];
+
+        uint32_t maxDay = daysInMonth[(isLeapYear(y) << 8) | m];
+        uint32_t isMonthValid = (m - 1) < 12;
+        uint32_t clampedMonth = isMonthValid ? m : 1;
+        uint32_t clampedDay = (d > maxDay) ? maxDay : (((d - 1) < 31) ? d : 1);
+        minuteOfDay = std::min(minuteOfDay, 24u * 60 - 1);
+
+        isInvalid[i] = static_cast<uint8_t>((isMonthValid ^ 1) | (d == 0) | (d > maxDay)
+                                            | (hours[i] > 23) | (minutes[i] > 59)
+                                            | (years[i] == INT16_MIN));
+
+        // Days since the epoch of the first of the month, the clamped day is added on top
+        uint32_t isBeforeMarch = clampedMonth <= 2;
+        uint32_t yearOfMarch = y - isBeforeMarch;
+        uint32_t era = yearOfMarch / 400;
+        uint32_t yearOfEra = yearOfMarch - era * 400;
+        uint32_t monthOfYear = clampedMonth + (isBeforeMarch ? 9 : -3u);
+        uint32_t dayOfYear = (153 * monthOfYear + 2) / 5 + clampedDay - 1;
+        uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        int32_t daysSinceEpoch = static_cast<int32_t>(era * 146097 + dayOfEra) - daysBeforeEpoch;
+
+        results[i] = static_cast<PackedDateTime>(daysSinceEpoch) * (24 * 60) + minuteOfDay;
+    }
+}
+
+void packBlock(const DateTimeFields &fields,
+               size_t first,
+               size_t count,
+               PackedDateTime *results,
+               uint8_t *isInvalid)
+{
+    packRange(fields, first, count, results, isInvalid);
+}
+
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+// The compiler vectorizes the same loop with 8 lanes and gathers from the day table
+__attribute__((target("avx2"))) void packBlockAvx2(const DateTimeFields &fields,
+                                                   size_t first,
+                                                   size_t count,
+                                                   PackedDateTime *results,
+                                                   uint8_t *isInvalid)
+{
+    packRange(fields, first, count, results, isInvalid);
+}
+#endif
 } // namespace
@@ -0,0 +1,419 @@
+#include "holidayimporter.h"
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string>
+
+using namespace std::chrono;
+
+namespace
+{
+constexpr size_t batchSize = 256;
+
+/*
+ * Dates are collected on the stack and handed to the bulk setters in
+ * batches, the buffer is never copied.
+ */
+struct HolidayBatch
+{
+    WorkdayCalendar &calendar;
+    HolidayImportResult &result;
+    std::array<Date, batchSize> holidays{};
+    size_t holidayCount = 0;
+    std::array<Date, batchSize> recurringHolidays{};
+    size_t recurringCount = 0;
+};
+
+enum class Recurrence
+{
+    None,
+    Yearly,
+    Unsupported
+};
+
+struct IcsEvent
+{
+    std::optional<Date> start{};
+    std::optional<Date> end{};
+    Recurrence recurrence = Recurrence::None;
+    uint32_t count = 0;
+    uint32_t interval = 1;
+    std::optional<Date> until{};
+    std::optional<uint32_t> byMonth{};
+    std::optional<uint32_t> byMonthDay{};
+};
+
+void addHoliday(HolidayBatch &batch, Date date);
+void addRecurringHoliday(HolidayBatch &batch, Date date);
+void flush(HolidayBatch &batch);
+void emitEvent(HolidayBatch &batch, const IcsEvent &event);
+bool isStartMatched(const IcsEvent &event);
+void parseRecurrenceRule(std::string_view rule, IcsEvent &event);
+std::string_view nextLine(std::string_view &buffer);
+std::string_view nextUnfoldedLine(std::string_view &buffer, std::string &scratch);
+std::string_view nextField(std::string_view &line, char separator);
+std::string_view trim(std::string_view text);
+std::optional<uint32_t> parseNumber(std::string_view text);
+std::optional<Date> parseDate(std::string_view yyyy, std::string_view mm, std::string_view dd);
+std::optional<Date> parseDateValue(std::string_view value);
+} // namespace
+
+HolidayImportResult importIcsHolidays(std::string_view buffer, WorkdayCalendar &calendar)
+{
+    HolidayImportResult result{};
+    HolidayBatch batch{.calendar = calendar, .result = result};
+    IcsEvent event{};
+    bool isInEvent = false;
+    std::string unfolded{};
+
+    while (!buffer.empty())
+    {
+        std::string_view line = nextUnfoldedLine(buffer, unfolded);
+        if (line.empty())
+        {
+            continue;
+        }
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos)
+        {
+            continue;
+        }
+        std::string_view value = line.substr(colon + 1);
+        std::string_view name = line.substr(0, std::min(colon, line.find(';')));
+
+        if (name == "BEGIN" && value == "VEVENT")
+        {
+            event = IcsEvent{};
+            isInEvent = true;
+        }
+        else if (isInEvent && name == "END" && value == "VEVENT")
+        {
+            emitEvent(batch, event);
+            isInEvent = false;
+        }
+        else if (isInEvent && name == "DTSTART")
+        {
+            event.start = parseDateValue(value);
+        }
+        else if (isInEvent && name == "DTEND")
+        {
+            event.end = parseDateValue(value);
+        }
+        else if (isInEvent && name == "RRULE")
+        {
+            parseRecurrenceRule(value, event);
+        }
+    }
+
+    flush(batch);
+    return result;
+}
+
+HolidayImportResult importCsvHolidays(std::string_view buffer, WorkdayCalendar &calendar)
+{
+    HolidayImportResult result{};
+    HolidayBatch batch{.calendar = calendar, .result = result};
+
+    while (!buffer.empty())
+    {
+        std::string_view line = nextLine(buffer);
+        if (trim(line).empty() || trim(line).front() == '#')
+        {
+            continue;
+        }
+
+        std::string_view field = trim(nextField(line, ','));
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+        {
+            field = trim(field.substr(1, field.size() - 2));
+        }
+
+        std::optional<Date> date{};
+        bool isRecurring = false;
+        if (field.size() == 10 && field[4] == '-' && field[7] == '-')
+        {
+            date = parseDate(field.substr(0, 4), field.substr(5, 2), field.substr(8, 2));
+        }
+        else if (field.size() == 8)
+        {
+            date = parseDate(field.substr(0, 4), field.substr(4, 2), field.substr(6, 2));
+        }
+        else if ((field.size() == 7 && field.starts_with("--"))
+                 || (field.size() == 5 && field[2] == '-'))
+        {
+            field.remove_prefix(field.size() - 5);
+            date = parseDate("2000", field.substr(0, 2), field.substr(3, 2));
+            isRecurring = true;
+        }
+
+        if (!date)
+        {
+            ++result.skipped;
+        }
+        else if (isRecurring)
+        {
+            addRecurringHoliday(batch, *date);
+        }
+        else
+        {
+            addHoliday(batch, *date);
+        }
+    }
+
+    flush(batch);
+    return result;
+}
+
+namespace
+{
+void addHoliday(HolidayBatch &batch, Date date)
+{
+    if (batch.holidayCount == batch.holidays.size())
+    {
+        flush(batch);
+    }
+    batch.holidays[batch.holidayCount++] = date;
+    ++batch.result.holidays;
+}
+
+void addRecurringHoliday(HolidayBatch &batch, Date date)
+{
+    if (batch.recurringCount == batch.recurringHolidays.size())
+    {
+        flush(batch);
+    }
+    batch.recurringHolidays[batch.recurringCount++] = date;
+    ++batch.result.recurringHolidays;
+}
+
+void flush(HolidayBatch &batch)
+{
+    // Every setter call refreshes the calendar's compiled tables, so empty lists are left out
+    if (batch.holidayCount > 0)
+    {
+        batch.calendar.setHolidays(
+            std::span<const Date>{batch.holidays.data(), batch.holidayCount});
+    }
+    if (batch.recurringCount > 0)
+    {
+        batch.calendar.setRecurringHolidays(
+            std::span<const Date>{batch.recurringHolidays.data(), batch.recurringCount});
+    }
+    batch.holidayCount = 0;
+    batch.recurringCount = 0;
+}
+
+void emitEvent(HolidayBatch &batch, const IcsEvent &event)
+{
+    bool isBounded = (event.count > 0) || event.until.has_value();
+    bool isOpenEndedYearly = (event.recurrence == Recurrence::Yearly) && !isBounded;
+    if (!isStartMatched(event) || (event.recurrence == Recurrence::Unsupported)
+        || (isOpenEndedYearly && event.interval != 1))
+    {
+        ++batch.result.skipped;
+        return;
+    }
+
+    // DTEND of an all-day event is exclusive
+    sys_days first{*event.start};
+    sys_days last = first;
+    if (event.end && sys_days{*event.end} > first)
+    {
+        last = sys_days{*event.end} - days{1};
+    }
+
+    for (sys_days d = first; d <= last; d += days{1})
+    {
+        if (event.recurrence == Recurrence::None)
+        {
+            addHoliday(batch, Date{d});
+        }
+        else if (isOpenEndedYearly)
+        {
+            addRecurringHoliday(batch, Date{d});
+        }
+        else
+        {
+            // A February 29 only exists in some years, only emitted occurrences use up COUNT
+            Date occurrence{d};
+            uint32_t emitted = 0;
+            while ((event.count == 0) || (emitted < event.count))
+            {
+                if (event.until && (occurrence > *event.until))
+                {
+                    break;
+                }
+                if (occurrence.ok())
+                {
+                    addHoliday(batch, occurrence);
+                    ++emitted;
+                }
+
+                int64_t nextYear = int64_t{static_cast<int>(occurrence.year())} + event.interval;
+                if (nextYear > static_cast<int>(year::max()))
+                {
+                    break; // Without COUNT or UNTIL in reach the calendar itself ends here
+                }
+                occurrence += years{event.interval};
+            }
+        }
+    }
+}
+
+bool isStartMatched(const IcsEvent &event)
+{
+    // BYMONTH and BYMONTHDAY are accepted when they only restate the date of DTSTART
+    if (!event.start)
+    {
+        return false;
+    }
+    if (event.byMonth && (*event.byMonth != unsigned{event.start->month()}))
+    {
+        return false;
+    }
+
+    return !event.byMonthDay || (*event.byMonthDay == unsigned{event.start->day()});
+}
+
+void parseRecurrenceRule(std::string_view rule, IcsEvent &event)
+{
+    event.recurrence = Recurrence::Unsupported;
+    bool isYearly = false;
+    bool isSupported = true;
+
+    while (!rule.empty())
+    {
+        std::string_view part = nextField(rule, ';');
+        std::string_view key = part.substr(0, part.find('='));
+        std::string_view value = part.substr(std::min(part.size(), key.size() + 1));
+
+        if (key == "FREQ")
+        {
+            isYearly = (value == "YEARLY");
+        }
+        else if (key == "COUNT")
+        {
+            event.count = parseNumber(value).value_or(0);
+        }
+        else if (key == "INTERVAL")
+        {
+            event.interval = std::max(parseNumber(value).value_or(1), 1u);
+        }
+        else if (key == "UNTIL" && value.size() >= 8)
+        {
+            event.until = parseDate(value.substr(0, 4), value.substr(4, 2), value.substr(6, 2));
+        }
+        else if (key == "BYMONTH" || key == "BYMONTHDAY")
+        {
+            // A list such as BYMONTH=1,7 names several dates and needs a rule engine
+            std::optional<uint32_t> number = parseNumber(value);
+            isSupported = isSupported && number.has_value();
+            (key == "BYMONTH" ? event.byMonth : event.byMonthDay) = number;
+        }
+        else if (key != "WKST")
+        {
+            isSupported = false; // BYDAY, BYSETPOS... need a rule engine
+        }
+    }
+
+    if (isYearly && isSupported)
+    {
+        event.recurrence = Recurrence::Yearly;
+    }
+}
+
+std::string_view nextLine(std::string_view &buffer)
+{
+    std::string_view line = nextField(buffer, '\n');
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+
+    return line;
+}
+
+std::string_view nextUnfoldedLine(std::string_view &buffer, std::string &scratch)
+{
+    // Long lines are folded with a line break followed by one space or tab, only those copy
+    std::string_view line = nextLine(buffer);
+    if (buffer.empty() || (buffer.front() != ' ' && buffer.front() != '\t'))
+    {
+        return line;
+    }
+
+    scratch.assign(line);
+    while (!buffer.empty() && (buffer.front() == ' ' || buffer.front() == '\t'))
+    {
+        scratch.append(nextLine(buffer).substr(1));
+    }
+
+    return scratch;
+}
+
+std::string_view nextField(std::string_view &line, char separator)
+{
+    size_t end = line.find(separator);
+    std::string_view result = line.substr(0, end);
+    line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1);
+
+    return result;
+}
+
+std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+    {
+        text.remove_suffix(1);
+    }
+
+    return text;
+}
+
+std::optional<uint32_t> parseNumber(std::string_view text)
+{
+    uint32_t result = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), result);
+    if (error != std::errc{} || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+std::optional<Date> parseDate(std::string_view yyyy, std::string_view mm, std::string_view dd)
+{
+    std::optional<uint32_t> y = parseNumber(yyyy);
+    std::optional<uint32_t> m = parseNumber(mm);
+    std::optional<uint32_t> d = parseNumber(dd);
+    if (!y || !m || !d)
+    {
+        return std::nullopt;
+    }
+
+    Date result{year{static_cast<int>(*y)}, month{*m}, day{*d}};
+    if (!result.ok())
+    {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+std::optional<Date> parseDateValue(std::string_view value)
+{
+    // Only all-day events are holidays, a date-time such as 20240517T090000Z is a meeting
+    if (value.size() != 8)
+    {
+        return std::nullopt;
+    }
+
+    return parseDate(value.substr(0, 4), value.substr(4, 2), value.substr(6, 2));
+}
+} // namespace
@@ -0,0 +1,44 @@
+#include "holidayset.h"
+#include <algorithm>
+
+using namespace std::chrono;
+
+namespace
+{
+void sortAndRemoveDuplicates(std::vector<Date> &dates);
+} // namespace
+
+HolidaySet makeHolidaySet(std::span<const Date> nonRecurring, std::span<const Date> recurring)
+{
+    HolidaySet result{};
+
+    result.nonRecurring.assign(nonRecurring.begin(), nonRecurring.end());
+    sortAndRemoveDuplicates(result.nonRecurring);
+
+    result.recurring.reserve(recurring.size());
+    for (Date holiday : recurring)
+    {
+        result.recurring.push_back(Date{year{0}, holiday.month(), holiday.day()});
+    }
+    sortAndRemoveDuplicates(result.recurring);
+
+    return result;
+}
+
+bool isHoliday(const HolidaySet &holidays, Date date)
+{
+    return std::binary_search(holidays.nonRecurring.begin(), holidays.nonRecurring.end(), date)
+           || std::binary_search(holidays.recurring.begin(),
+                                 holidays.recurring.end(),
+                                 Date{year{0}, date.month(), date.day()});
+}
+
+namespace
+{
+void sortAndRemoveDuplicates(std::vector<Date> &dates)
+{
+    std::sort(dates.begin(), dates.end());
+    dates.erase(std::unique(dates.begin(), dates.end()), dates.end());
+    dates.shrink_to_fit();
+}
+} // namespace
@@ -0,0 +1,173 @@
+#include "numatopology.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace
+{
+std::vector<uint32_t> getAllowedCpus(void);
+std::vector<uint32_t> parseCpuList(std::string_view list);
+} // namespace
+
+std::vector<NumaNode> readNumaTopology(const std::string &root)
+{
+    std::vector<uint32_t> allowed = getAllowedCpus();
+    std::vector<NumaNode> nodes{};
+
+    std::error_code error{};
+    for (const auto &entry : std::filesystem::directory_iterator{root, error})
+    {
+        std::string name = entry.path().filename().string();
+        if (!name.starts_with("node"))
+        {
+            continue;
+        }
+        uint32_t id = 0;
+        const char *last = name.data() + name.size();
+        auto [end, status] = std::from_chars(name.data() + 4, last, id);
+        if ((status != std::errc{}) || (end != last))
+        {
+            continue;
+        }
+
+        std::ifstream file{entry.path() / "cpulist"};
+        std::string list{};
+        std::getline(file, list);
+
+        NumaNode node{.id = id, .cpus = {}};
+        for (uint32_t cpu : parseCpuList(list))
+        {
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu))
+            {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty())
+        {
+            nodes.push_back(std::move(node));
+        }
+    }
+
+    if (nodes.empty())
+    {
+        return {NumaNode{.id = 0, .cpus = std::move(allowed)}};
+    }
+
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode &lhs, const NumaNode &rhs) {
+        return lhs.id < rhs.id;
+    });
+    return nodes;
+}
+
+std::vector<NumaNode> emulateNumaTopology(const std::vector<NumaNode> &topology,
+                                          uint32_t numberOfNodes)
+{
+    std::vector<uint32_t> cpus{};
+    for (const NumaNode &node : topology)
+    {
+        cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+    }
+
+    // Never more nodes than CPUs, every pretend node needs somewhere to run
+    numberOfNodes = std::clamp(numberOfNodes, 1u, std::max(static_cast<uint32_t>(cpus.size()), 1u));
+    std::vector<NumaNode> nodes(numberOfNodes);
+    for (uint32_t i = 0; i < numberOfNodes; ++i)
+    {
+        nodes[i].id = i;
+        size_t first = cpus.size() * i / numberOfNodes;
+        size_t last = cpus.size() * (i + 1) / numberOfNodes;
+        nodes[i].cpus.assign(cpus.begin() + static_cast<std::ptrdiff_t>(first),
+                             cpus.begin() + static_cast<std::ptrdiff_t>(last));
+    }
+
+    return nodes;
+}
+
+bool pinCurrentThread(const NumaNode &node)
+{
+#ifdef __linux__
+    cpu_set_t set{};
+    CPU_ZERO(&set);
+    for (uint32_t cpu : node.cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    return !node.cpus.empty() && (sched_setaffinity(0, sizeof(set), &set) == 0);
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+namespace
+{
+std::vector<uint32_t> getAllowedCpus(void)
+{
+    std::vector<uint32_t> cpus{};
+#ifdef __linux__
+    cpu_set_t set{};
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty())
+    {
+        cpus.resize(std::max(std::thread::hardware_concurrency(), 1u));
+        for (uint32_t cpu = 0; cpu < cpus.size(); ++cpu)
+        {
+            cpus[cpu] = cpu;
+        }
+    }
+
+    return cpus;
+}
+
+std::vector<uint32_t> parseCpuList(std::string_view list)
+{
+    // Comma separated CPUs and inclusive ranges, such as "0-3,8-11"
+    std::vector<uint32_t> cpus{};
+    const char *position = list.data();
+    const char *end = list.data() + list.size();
+    while (position < end)
+    {
+        uint32_t first = 0;
+        std::from_chars_result parsed = std::from_chars(position, end, first);
+        uint32_t last = first;
+        if ((parsed.ec == std::errc{}) && (parsed.ptr < end) && (*parsed.ptr == '-'))
+        {
+            parsed = std::from_chars(parsed.ptr + 1, end, last);
+        }
+        if (parsed.ec != std::errc{})
+        {
+            break;
+        }
+        const char *next = parsed.ptr;
+        for (uint64_t cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+
+        position = (next < end) && (*next == ',') ? next + 1 : end;
+    }
+
+    return cpus;
+}
+} // namespace
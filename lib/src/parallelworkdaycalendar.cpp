@@ -0,0 +1,202 @@
+#include "parallelworkdaycalendar.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace
+{
+std::unique_ptr<WorkdayCalendar> replicateOnNode(const WorkdayCalendar &calendar,
+                                                 const NumaNode &node);
+} // namespace
+
+ParallelWorkdayCalendar::ParallelWorkdayCalendar(const WorkdayCalendar &calendar,
+                                                 std::vector<NumaNode> topology,
+                                                 ReplicaPlacement placement)
+{
+    std::erase_if(topology, [](const NumaNode &node) { return node.cpus.empty(); });
+    if (topology.empty())
+    {
+        topology = readNumaTopology();
+    }
+
+    if (placement == ReplicaPlacement::PerNode)
+    {
+        for (const NumaNode &node : topology)
+        {
+            replicas_.push_back(replicateOnNode(calendar, node));
+        }
+    }
+    else
+    {
+        replicas_.push_back(std::make_unique<WorkdayCalendar>(calendar.replicate()));
+    }
+
+    for (const NumaNode &node : topology)
+    {
+        numberOfWorkers_ += node.cpus.size();
+    }
+
+    // Frozen replicas are only read, so all workers of a node share one
+    try
+    {
+        for (size_t n = 0; n < topology.size(); ++n)
+        {
+            WorkdayCalendar &replica = *replicas_[std::min(n, replicas_.size() - 1)];
+            for (uint32_t cpu : topology[n].cpus)
+            {
+                NumaNode place{.id = topology[n].id, .cpus = {cpu}};
+                workers_.emplace_back([this, worker = workers_.size(), place, &replica] {
+                    runWorker(worker, place, replica);
+                });
+            }
+        }
+    }
+    catch (...)
+    {
+        stopWorkers();
+        throw;
+    }
+}
+
+ParallelWorkdayCalendar::~ParallelWorkdayCalendar(void)
+{
+    stopWorkers();
+}
+
+void ParallelWorkdayCalendar::getWorkdayIncrements(std::span<const PackedDateTime> startDates,
+                                                   std::span<const float> incrementWorkdays,
+                                                   std::span<PackedDateTime> results,
+                                                   BatchOrder order)
+{
+    size_t count = std::min({startDates.size(), incrementWorkdays.size(), results.size()});
+    if (count == 0)
+    {
+        return;
+    }
+
+    // One batch in flight at a time, the workers hold spans into it
+    std::lock_guard query{queryMutex_};
+    std::unique_lock lock{mutex_};
+    batch_ = {.startDates = startDates.first(count),
+              .incrementWorkdays = incrementWorkdays.first(count),
+              .results = results.first(count),
+              .order = order};
+    pending_ = numberOfWorkers_;
+    error_ = nullptr;
+    ++generation_;
+    wake_.notify_all();
+
+    done_.wait(lock, [this] { return pending_ == 0; });
+    if (error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+size_t ParallelWorkdayCalendar::getNumberOfReplicas(void) const
+{
+    return replicas_.size();
+}
+
+size_t ParallelWorkdayCalendar::getNumberOfWorkers(void) const
+{
+    return numberOfWorkers_;
+}
+
+void ParallelWorkdayCalendar::stopWorkers(void)
+{
+    {
+        std::lock_guard lock{mutex_};
+        isStopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ParallelWorkdayCalendar::runWorker(size_t worker,
+                                        const NumaNode &place,
+                                        WorkdayCalendar &replica)
+{
+    pinCurrentThread(place);
+
+    uint64_t seenGeneration = 0;
+    std::unique_lock lock{mutex_};
+    while (true)
+    {
+        wake_.wait(lock, [this, seenGeneration] {
+            return isStopping_ || (generation_ != seenGeneration);
+        });
+        if (isStopping_)
+        {
+            return;
+        }
+        seenGeneration = generation_;
+        Batch batch = batch_;
+        lock.unlock();
+
+        // Contiguous slices keep a sorted batch sorted for every worker
+        size_t count = batch.startDates.size();
+        size_t first = count * worker / numberOfWorkers_;
+        size_t last = count * (worker + 1) / numberOfWorkers_;
+        std::exception_ptr error{};
+        if (first < last)
+        {
+            try
+            {
+                replica.getWorkdayIncrements(batch.startDates.subspan(first, last - first),
+                                             batch.incrementWorkdays.subspan(first, last - first),
+                                             batch.results.subspan(first, last - first),
+                                             batch.order);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+
+        // A failed worker still reports in, otherwise the caller would wait forever
+        lock.lock();
+        if (error && !error_)
+        {
+            error_ = error;
+        }
+        if (--pending_ == 0)
+        {
+            done_.notify_one();
+        }
+    }
+}
+
+namespace
+{
+std::unique_ptr<WorkdayCalendar> replicateOnNode(const WorkdayCalendar &calendar,
+                                                 const NumaNode &node)
+{
+    // The copy has to be made by a thread already running on the node for first-touch to work
+    std::unique_ptr<WorkdayCalendar> replica{};
+    std::exception_ptr error{};
+    std::thread builder{[&calendar, &node, &replica, &error] {
+        pinCurrentThread(node);
+        try
+        {
+            replica = std::make_unique<WorkdayCalendar>(calendar.replicate());
+        }
+        catch (...)
+        {
+            // Escaping the thread would terminate, the caller rethrows after the join
+            error = std::current_exception();
+        }
+    }};
+    builder.join();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return replica;
+}
+} // namespace
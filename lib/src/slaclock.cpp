@@ -0,0 +1,207 @@
+#include "slaclock.h"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace
+{
+constexpr int64_t minutesPerDay = 24 * 60;
+
+std::span<const WorkingInterval> normalize(std::span<const WorkingInterval> intervals,
+                                           std::vector<WorkingInterval> &scratch);
+void checkOffsets(std::span<const uint32_t> offsets, size_t numberOfIntervals);
+int64_t floorDivide(int64_t value, int64_t divisor);
+} // namespace
+
+SlaClock::SlaClock(WorkdayBitmap bitmap, Time startWorkday, Time stopWorkday)
+    : bitmap_(std::move(bitmap))
+{
+    firstDay_ = bitmap_.getFirstDay().time_since_epoch().count();
+    numberOfDays_ = (bitmap_.getLastDay() - bitmap_.getFirstDay()).count() + 1;
+    startMinute_ = duration_cast<minutes>(startWorkday.to_duration()).count();
+    stopMinute_ = std::max(duration_cast<minutes>(stopWorkday.to_duration()).count(), startMinute_);
+
+    // One entry past the last word holds the working days of the whole bitmap
+    std::span<const uint64_t> words = bitmap_.getWords();
+    workdaysBeforeWord_.assign(words.size() + 1, 0);
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+        workdaysBeforeWord_[i + 1] = workdaysBeforeWord_[i] + std::popcount(words[i]);
+    }
+}
+
+minutes SlaClock::getWorkingTime(WorkingInterval interval) const
+{
+    if (interval.stop <= interval.start)
+    {
+        return minutes{0};
+    }
+
+    return minutes{getWorkingMinutesUpTo(interval.stop) - getWorkingMinutesUpTo(interval.start)};
+}
+
+minutes SlaClock::getWorkingTime(std::span<const WorkingInterval> open,
+                                 std::span<const WorkingInterval> paused) const
+{
+    std::vector<WorkingInterval> openScratch{};
+    std::vector<WorkingInterval> pausedScratch{};
+    return subtractPauses(normalize(open, openScratch), normalize(paused, pausedScratch));
+}
+
+void SlaClock::getWorkingTimes(std::span<const WorkingInterval> open,
+                               std::span<const uint32_t> openOffsets,
+                               std::span<const WorkingInterval> paused,
+                               std::span<const uint32_t> pausedOffsets,
+                               std::span<minutes> results) const
+{
+    // Offsets hold one entry per entity plus the end of the last one
+    checkOffsets(openOffsets, open.size());
+    checkOffsets(pausedOffsets, paused.size());
+    size_t count = results.size();
+    count = std::min(count, openOffsets.empty() ? 0 : openOffsets.size() - 1);
+    count = std::min(count, pausedOffsets.empty() ? 0 : pausedOffsets.size() - 1);
+
+    // Scratch space is only touched by entities whose intervals arrive unsorted
+    std::vector<WorkingInterval> openScratch{};
+    std::vector<WorkingInterval> pausedScratch{};
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::span<const WorkingInterval> entityOpen
+            = open.subspan(openOffsets[i], openOffsets[i + 1] - openOffsets[i]);
+        std::span<const WorkingInterval> entityPaused
+            = paused.subspan(pausedOffsets[i], pausedOffsets[i + 1] - pausedOffsets[i]);
+        results[i] = subtractPauses(normalize(entityOpen, openScratch),
+                                    normalize(entityPaused, pausedScratch));
+    }
+}
+
+int64_t SlaClock::getWorkingMinutesUpTo(PackedDateTime timestamp) const
+{
+    int64_t workdayLength = stopMinute_ - startMinute_;
+    int64_t day = floorDivide(timestamp, minutesPerDay);
+    int64_t offset = day - firstDay_;
+    if (offset < 0)
+    {
+        return 0;
+    }
+    if (offset >= numberOfDays_)
+    {
+        return workdaysBeforeWord_.back() * workdayLength;
+    }
+
+    size_t word = static_cast<size_t>(offset / WorkdayBitmap::daysPerWord);
+    int64_t bit = offset % WorkdayBitmap::daysPerWord;
+    uint64_t bits = bitmap_.getWords()[word];
+    int64_t workdays
+        = workdaysBeforeWord_[word] + std::popcount(bits & ((uint64_t{1} << bit) - 1));
+
+    // Same clamping into the working hours as the increment kernels do for a start time
+    int64_t result = workdays * workdayLength;
+    if ((bits >> bit) & 1u)
+    {
+        int64_t timeOfDay = timestamp - day * minutesPerDay;
+        result += std::clamp(timeOfDay, startMinute_, stopMinute_) - startMinute_;
+    }
+
+    return result;
+}
+
+minutes SlaClock::subtractPauses(std::span<const WorkingInterval> open,
+                                 std::span<const WorkingInterval> paused) const
+{
+    // Both lists are sorted and disjoint, so one pass over each suffices
+    int64_t result = 0;
+    size_t firstPause = 0;
+    for (const WorkingInterval &interval : open)
+    {
+        PackedDateTime covered = interval.start;
+        while ((firstPause < paused.size()) && (paused[firstPause].stop <= covered))
+        {
+            ++firstPause;
+        }
+
+        for (size_t i = firstPause; (i < paused.size()) && (paused[i].start < interval.stop); ++i)
+        {
+            if (paused[i].start > covered)
+            {
+                result += getWorkingMinutesUpTo(paused[i].start) - getWorkingMinutesUpTo(covered);
+            }
+            covered = std::max(covered, paused[i].stop);
+        }
+
+        if (covered < interval.stop)
+        {
+            result += getWorkingMinutesUpTo(interval.stop) - getWorkingMinutesUpTo(covered);
+        }
+    }
+
+    return minutes{result};
+}
+
+namespace
+{
+std::span<const WorkingInterval> normalize(std::span<const WorkingInterval> intervals,
+                                           std::vector<WorkingInterval> &scratch)
+{
+    bool isNormalized = std::all_of(intervals.begin(), intervals.end(), [](const auto &interval) {
+        return interval.start < interval.stop;
+    });
+    for (size_t i = 1; isNormalized && (i < intervals.size()); ++i)
+    {
+        isNormalized = intervals[i - 1].stop <= intervals[i].start;
+    }
+    if (isNormalized)
+    {
+        return intervals;
+    }
+
+    scratch.clear();
+    std::copy_if(intervals.begin(),
+                 intervals.end(),
+                 std::back_inserter(scratch),
+                 [](const auto &interval) { return interval.start < interval.stop; });
+    std::sort(scratch.begin(), scratch.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.start < rhs.start;
+    });
+
+    // Merge overlapping and touching intervals in place
+    size_t merged = 0;
+    for (size_t i = 1; i < scratch.size(); ++i)
+    {
+        if (scratch[i].start <= scratch[merged].stop)
+        {
+            scratch[merged].stop = std::max(scratch[merged].stop, scratch[i].stop);
+        }
+        else
+        {
+            scratch[++merged] = scratch[i];
+        }
+    }
+    scratch.resize(scratch.empty() ? 0 : merged + 1);
+
+    return scratch;
+}
+
+void checkOffsets(std::span<const uint32_t> offsets, size_t numberOfIntervals)
+{
+    // Every row is sliced out of the interval list, so a bad offset would read past it
+    if (offsets.empty())
+    {
+        return;
+    }
+    if (!std::is_sorted(offsets.begin(), offsets.end()) || (offsets.back() != numberOfIntervals))
+    {
+        throw std::invalid_argument{"SlaClock: offsets must ascend and end at the interval count"};
+    }
+}
+
+int64_t floorDivide(int64_t value, int64_t divisor)
+{
+    int64_t quotient = value / divisor;
+    return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+} // namespace
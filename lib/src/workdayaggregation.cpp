@@ -0,0 +1,123 @@
+#include "workdayaggregation.h"
+
+using namespace std::chrono;
+
+namespace
+{
+sys_days getPeriodStart(sys_days day, AggregationPeriod period);
+sys_days getNextPeriodStart(sys_days periodStart, AggregationPeriod period);
+std::vector<sys_days> makeBoundaries(sys_days firstDay, sys_days lastDay, AggregationPeriod period);
+std::vector<PeriodWorkload> countPerPeriod(const WorkdayBitmap &bitmap,
+                                           minutes workdayLength,
+                                           std::span<const sys_days> boundaries);
+} // namespace
+
+std::vector<PeriodWorkload> aggregateWorkload(const WorkdayCalendar &calendar,
+                                              Date firstDay,
+                                              Date lastDay,
+                                              AggregationPeriod period)
+{
+    return aggregateWorkload(std::span<const WorkdayCalendar>{&calendar, 1},
+                             firstDay,
+                             lastDay,
+                             period)
+        .front();
+}
+
+std::vector<std::vector<PeriodWorkload>> aggregateWorkload(
+    std::span<const WorkdayCalendar> calendars,
+    Date firstDay,
+    Date lastDay,
+    AggregationPeriod period)
+{
+    std::vector<std::vector<PeriodWorkload>> result{};
+    result.reserve(calendars.size());
+
+    // Bucket boundaries are shared by every calendar, only the bitmaps differ
+    std::vector<sys_days> boundaries
+        = makeBoundaries(sys_days{firstDay}, sys_days{lastDay}, period);
+    for (const WorkdayCalendar &calendar : calendars)
+    {
+        WorkdayBitmap bitmap = calendar.compile(firstDay, lastDay);
+        result.push_back(countPerPeriod(bitmap, calendar.getWorkdayLength(), boundaries));
+    }
+
+    return result;
+}
+
+namespace
+{
+sys_days getPeriodStart(sys_days day, AggregationPeriod period)
+{
+    year_month_day ymd{day};
+    switch (period)
+    {
+    case AggregationPeriod::PerWeek:
+        return day - (weekday{day} - Monday);
+    case AggregationPeriod::PerMonth:
+        return sys_days{ymd.year() / ymd.month() / 1};
+    case AggregationPeriod::PerQuarter:
+    {
+        unsigned int firstMonth = ((static_cast<unsigned int>(ymd.month()) - 1) / 3) * 3 + 1;
+        return sys_days{ymd.year() / month{firstMonth} / 1};
+    }
+    case AggregationPeriod::PerYear:
+    default:
+        return sys_days{ymd.year() / January / 1};
+    }
+}
+
+sys_days getNextPeriodStart(sys_days periodStart, AggregationPeriod period)
+{
+    year_month_day ymd{periodStart};
+    switch (period)
+    {
+    case AggregationPeriod::PerWeek:
+        return periodStart + weeks{1};
+    case AggregationPeriod::PerMonth:
+        return sys_days{ymd + months{1}};
+    case AggregationPeriod::PerQuarter:
+        return sys_days{ymd + months{3}};
+    case AggregationPeriod::PerYear:
+    default:
+        return sys_days{ymd + years{1}};
+    }
+}
+
+std::vector<sys_days> makeBoundaries(sys_days firstDay, sys_days lastDay, AggregationPeriod period)
+{
+    std::vector<sys_days> result{firstDay};
+    if (lastDay < firstDay)
+    {
+        return result;
+    }
+
+    sys_days next = getNextPeriodStart(getPeriodStart(firstDay, period), period);
+    while (next <= lastDay)
+    {
+        result.push_back(next);
+        next = getNextPeriodStart(next, period);
+    }
+    result.push_back(lastDay + days{1});
+
+    return result;
+}
+
+std::vector<PeriodWorkload> countPerPeriod(const WorkdayBitmap &bitmap,
+                                           minutes workdayLength,
+                                           std::span<const sys_days> boundaries)
+{
+    std::vector<PeriodWorkload> result{};
+    result.reserve(boundaries.size() - 1);
+
+    for (size_t i = 0; i + 1 < boundaries.size(); ++i)
+    {
+        uint32_t workdays = bitmap.countWorkdays(boundaries[i], boundaries[i + 1] - days{1});
+        result.push_back({.periodStart = Date{boundaries[i]},
+                          .workdays = workdays,
+                          .workingTime = workdayLength * workdays});
+    }
+
+    return result;
+}
+} // namespace
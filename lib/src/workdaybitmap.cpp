@@ -0,0 +1,96 @@
+#include "workdaybitmap.h"
+#include <algorithm>
+#include <bit>
+
+using namespace std::chrono;
+
+namespace
+{
+uint64_t maskFrom(int64_t bit);
+uint64_t maskUpTo(int64_t bit);
+} // namespace
+
+WorkdayBitmap::WorkdayBitmap(sys_days firstDay, sys_days lastDay)
+    : firstDay_(firstDay), lastDay_(std::max(firstDay, lastDay))
+{
+    int64_t numberOfDays = (lastDay_ - firstDay_).count() + 1;
+    words_.assign(static_cast<size_t>((numberOfDays + daysPerWord - 1) / daysPerWord), 0);
+}
+
+sys_days WorkdayBitmap::getFirstDay(void) const
+{
+    return firstDay_;
+}
+
+sys_days WorkdayBitmap::getLastDay(void) const
+{
+    return lastDay_;
+}
+
+bool WorkdayBitmap::contains(sys_days day) const
+{
+    return (day >= firstDay_) && (day <= lastDay_);
+}
+
+bool WorkdayBitmap::isWorkday(sys_days day) const
+{
+    int64_t offset = (day - firstDay_).count();
+    return (words_[static_cast<size_t>(offset / daysPerWord)] >> (offset % daysPerWord)) & 1u;
+}
+
+void WorkdayBitmap::setWorkday(sys_days day, bool isWorking)
+{
+    int64_t offset = (day - firstDay_).count();
+    uint64_t bit = uint64_t{1} << (offset % daysPerWord);
+    uint64_t &word = words_[static_cast<size_t>(offset / daysPerWord)];
+    word = isWorking ? (word | bit) : (word & ~bit);
+}
+
+uint32_t WorkdayBitmap::countWorkdays(sys_days from, sys_days to) const
+{
+    from = std::max(from, firstDay_);
+    to = std::min(to, lastDay_);
+    if (from > to)
+    {
+        return 0;
+    }
+
+    int64_t first = (from - firstDay_).count();
+    int64_t last = (to - firstDay_).count();
+    size_t firstWord = static_cast<size_t>(first / daysPerWord);
+    size_t lastWord = static_cast<size_t>(last / daysPerWord);
+
+    if (firstWord == lastWord)
+    {
+        uint64_t mask = maskFrom(first % daysPerWord) & maskUpTo(last % daysPerWord);
+        return static_cast<uint32_t>(std::popcount(words_[firstWord] & mask));
+    }
+
+    uint32_t result = static_cast<uint32_t>(
+        std::popcount(words_[firstWord] & maskFrom(first % daysPerWord)));
+    for (size_t i = firstWord + 1; i < lastWord; ++i)
+    {
+        result += static_cast<uint32_t>(std::popcount(words_[i]));
+    }
+    result += static_cast<uint32_t>(std::popcount(words_[lastWord] & maskUpTo(last % daysPerWord)));
+
+    return result;
+}
+
+std::span<const uint64_t> WorkdayBitmap::getWords(void) const
+{
+    return words_;
+}
+
+namespace
+{
+uint64_t maskFrom(int64_t bit)
+{
+    return ~uint64_t{0} << bit;
+}
+
+uint64_t maskUpTo(int64_t bit)
+{
+    return ~uint64_t{0} >> (WorkdayBitmap::daysPerWord - 1 - bit);
+}
+} // namespace
@@ -1,10 +1,22 @@
 #include "workdaycalendar.h"
+#include "workingtimeclassifier.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <initializer_list>
+#include <optional>
 #include <span>
+#include <utility>
 
 using namespace std::chrono;
 
 namespace
 {
+// Widest span compiled for one batch, about 180 years in 8 KiB
+constexpr int64_t maxClassifiedDays = int64_t{1} << 16;
+constexpr sys_days firstRepresentableDay = sys_days{year::min() / January / day{1}};
+constexpr sys_days lastRepresentableDay = sys_days{year::max() / December / day{31}};
+
 struct WorkdayDurationsInMinutes
 {
     minutes workDay;
@@ -18,8 +30,56 @@ struct Holidays
 {
     std::span<const Date> nonRecurring;
     std::span<const Date> recurring;
+    const HolidaySet *shared;
 };
 
+struct IncrementContext
+{
+    Time startWorkday;
+    Time stopWorkday;
+    Holidays holidays;
+    const WorkdayIndex *index;
+    const CompressedWorkdayTable *compressed;
+};
+
+using IncrementKernel = DateTime (*)(DateTime, float, const IncrementContext &);
+
+template <int Sign, bool IsHolidayFree, bool IsWholeDay>
+DateTime incrementKernel(DateTime startDate,
+                         float incrementWorkdays,
+                         const IncrementContext &context);
+
+template <int Sign>
+sys_days clampToWeekday(sys_days day);
+
+template <int Sign>
+sys_days addWeekdays(sys_days day, int32_t workdays);
+
+IncrementKernel selectKernel(float incrementWorkdays, bool isHolidayFree);
+
+/*
+ * Position in a compiled bitmap that moves with a sorted batch. The rank of
+ * a day is the number of working days from the start of the bitmap up to
+ * and including that day.
+ */
+struct SweepCursor
+{
+    std::span<const uint64_t> words;
+    sys_days firstDay;
+    sys_days lastDay;
+    size_t word;
+    int64_t rankBeforeWord;
+};
+
+void sweepSortedBatch(std::span<const PackedDateTime> startDates,
+                      std::span<const float> incrementWorkdays,
+                      std::span<PackedDateTime> results,
+                      const WorkdayBitmap &bitmap,
+                      const IncrementContext &context);
+std::optional<sys_days> sweepEndDay(SweepCursor &cursor, sys_days day, float incrementWorkdays);
+int64_t moveCursor(SweepCursor &cursor, sys_days day);
+std::optional<sys_days> findByRank(SweepCursor cursor, int64_t rank);
+
 WorkdayDurationsInMinutes calculateTimeDuration(Time startTime,
                                                 float incrementWorkdays,
                                                 Time startWorkday,
@@ -37,9 +97,15 @@ time_point<system_clock, minutes> clampStartDate(float incrementWorkdays,
                                                  time_point<system_clock, minutes> timePoint,
                                                  Holidays holidays);
 
+template <typename Index>
+std::optional<Date> calculateEndDate(float incrementWorkdays,
+                                     time_point<system_clock, minutes> timePoint,
+                                     const Index &index);
+
 time_point<system_clock, minutes> makeTimepoint(DateTime dt);
 minutes clampStartTime(const WorkdayDurationsInMinutes &time);
 days calculateIncrement(float incrementWorkdays);
+void clearHolidays(WorkdayBitmap &bitmap, Holidays holidays);
 bool isWeekend(Date date);
 bool isHoliday(Date date, Holidays holidays);
 } // namespace
@@ -47,11 +113,54 @@ bool isHoliday(Date date, Holidays holidays);
 void WorkdayCalendar::setHoliday(GregorianCalendar date)
 {
     nonRecurringHolidays_.push_back(date.getDate());
+    markIndexedHoliday(date.getDate(), false);
+    refreshCompressedTable();
 }
 
 void WorkdayCalendar::setRecurringHoliday(GregorianCalendar date)
 {
     recurringHolidays_.push_back(date.getDate());
+    markIndexedHoliday(date.getDate(), true);
+    refreshCompressedTable();
+}
+
+void WorkdayCalendar::setHolidays(std::span<const Date> dates)
+{
+    nonRecurringHolidays_.insert(nonRecurringHolidays_.end(), dates.begin(), dates.end());
+    for (Date date : dates)
+    {
+        markIndexedHoliday(date, false);
+    }
+    refreshCompressedTable();
+}
+
+void WorkdayCalendar::setRecurringHolidays(std::span<const Date> dates)
+{
+    recurringHolidays_.insert(recurringHolidays_.end(), dates.begin(), dates.end());
+    for (Date date : dates)
+    {
+        markIndexedHoliday(date, true);
+    }
+    refreshCompressedTable();
+}
+
+void WorkdayCalendar::removeHoliday(GregorianCalendar date)
+{
+    detachSharedHolidays();
+    std::erase(nonRecurringHolidays_, date.getDate());
+    refreshIndex(date.getDate(), false);
+    refreshCompressedTable();
+}
+
+void WorkdayCalendar::removeRecurringHoliday(GregorianCalendar date)
+{
+    Date removed = date.getDate();
+    detachSharedHolidays();
+    std::erase_if(recurringHolidays_, [removed](Date holiday) {
+        return (holiday.month() == removed.month()) && (holiday.day() == removed.day());
+    });
+    refreshIndex(removed, true);
+    refreshCompressedTable();
 }
 
 void WorkdayCalendar::setWorkdayStartAndStop(GregorianCalendar startTime,
@@ -62,26 +171,601 @@ void WorkdayCalendar::setWorkdayStartAndStop(GregorianCalendar startTime,
 }
 
 DateTime WorkdayCalendar::getWorkdayIncrement(DateTime startDate, float incrementWorkdays)
+{
+    IncrementContext context{.startWorkday = start_,
+                             .stopWorkday = stop_,
+                             .holidays = {.nonRecurring = nonRecurringHolidays_,
+                                          .recurring = recurringHolidays_,
+                                          .shared = sharedHolidays_.get()},
+                             .index = index_.get(),
+                             .compressed = compressed_.get()};
+
+    return selectKernel(incrementWorkdays, isHolidayFree())(startDate, incrementWorkdays, context);
+}
+
+void WorkdayCalendar::getWorkdayIncrements(std::span<const PackedDateTime> startDates,
+                                           std::span<const float> incrementWorkdays,
+                                           std::span<PackedDateTime> results,
+                                           BatchOrder order)
+{
+    IncrementContext context{.startWorkday = start_,
+                             .stopWorkday = stop_,
+                             .holidays = {.nonRecurring = nonRecurringHolidays_,
+                                          .recurring = recurringHolidays_,
+                                          .shared = sharedHolidays_.get()},
+                             .index = index_.get(),
+                             .compressed = compressed_.get()};
+    bool isFree = isHolidayFree();
+
+    size_t count = std::min({startDates.size(), incrementWorkdays.size(), results.size()});
+    startDates = startDates.first(count);
+    incrementWorkdays = incrementWorkdays.first(count);
+    results = results.first(count);
+
+    // Weekend-only calendars are already closed form, sweeping only pays off with holidays
+    bool isSorted = (order == BatchOrder::Sorted)
+                    || ((order == BatchOrder::Detect)
+                        && std::is_sorted(startDates.begin(), startDates.end()));
+    if (isSorted && !isFree && (count > 1))
+    {
+        float largestIncrement = 0.0f;
+        for (float increment : incrementWorkdays)
+        {
+            largestIncrement = std::max(largestIncrement, std::abs(increment));
+        }
+
+        // Two calendar days per working day leaves room for weekends and holidays, anything
+        // running off the bitmap falls back to the single-query kernels
+        days margin{std::min(static_cast<int64_t>(largestIncrement) * 2 + 14, int64_t{7305})};
+        sys_days firstDay = floor<days>(sys_time<minutes>{minutes{startDates.front()}}) - margin;
+        sys_days lastDay = floor<days>(sys_time<minutes>{minutes{startDates.back()}}) + margin;
+
+        if (index_ && index_->contains(firstDay) && index_->contains(lastDay))
+        {
+            sweepSortedBatch(startDates, incrementWorkdays, results, index_->getBitmap(), context);
+            return;
+        }
+
+        // A sparse batch spread over centuries costs more to compile than to answer query by
+        // query, so only bounded spans are swept without an index
+        if (((lastDay - firstDay).count() < maxClassifiedDays)
+            && (firstDay >= firstRepresentableDay)
+            && (lastDay <= lastRepresentableDay))
+        {
+            WorkdayBitmap bitmap = compile(Date{firstDay}, Date{lastDay});
+            sweepSortedBatch(startDates, incrementWorkdays, results, bitmap, context);
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        IncrementKernel kernel = selectKernel(incrementWorkdays[i], isFree);
+        DateTime result = kernel(unpackDateTime(startDates[i]), incrementWorkdays[i], context);
+        results[i] = packDateTime(result);
+    }
+}
+
+void WorkdayCalendar::classifyWorkingTime(std::span<const PackedDateTime> timestamps,
+                                          std::span<uint64_t> workingMask) const
+{
+    timestamps = timestamps.first(std::min(timestamps.size(), workingMask.size() * 64));
+    if (timestamps.empty())
+    {
+        return;
+    }
+
+    auto [lowest, highest] = std::minmax_element(timestamps.begin(), timestamps.end());
+    sys_days firstDay = floor<days>(sys_time<minutes>{minutes{*lowest}});
+    sys_days lastDay = floor<days>(sys_time<minutes>{minutes{*highest}});
+
+    if (index_ && index_->contains(firstDay) && index_->contains(lastDay))
+    {
+        ::classifyWorkingTime(index_->getBitmap(), start_, stop_, timestamps, workingMask);
+        return;
+    }
+
+    // A far-off timestamp must not size the bitmap, so at most maxClassifiedDays around the
+    // median are compiled and the timestamps outside are looked up one by one
+    if ((lastDay - firstDay).count() >= maxClassifiedDays)
+    {
+        std::vector<PackedDateTime> sorted{timestamps.begin(), timestamps.end()};
+        auto median = sorted.begin() + static_cast<std::ptrdiff_t>(sorted.size() / 2);
+        std::nth_element(sorted.begin(), median, sorted.end());
+        sys_days medianDay = floor<days>(sys_time<minutes>{minutes{*median}});
+        firstDay = std::max(firstDay, medianDay - days{maxClassifiedDays / 2});
+        lastDay = std::min(lastDay, firstDay + days{maxClassifiedDays - 1});
+    }
+    firstDay = std::max(firstDay, firstRepresentableDay);
+    lastDay = std::min(lastDay, lastRepresentableDay);
+    if (firstDay > lastDay)
+    {
+        firstDay = std::clamp(firstDay, firstRepresentableDay, lastRepresentableDay);
+        lastDay = firstDay;
+    }
+
+    WorkdayBitmap bitmap = compile(Date{firstDay}, Date{lastDay});
+    ::classifyWorkingTime(bitmap, start_, stop_, timestamps, workingMask);
+
+    std::optional<HolidaySet> holidays{};
+    for (size_t i = 0; i < timestamps.size(); ++i)
+    {
+        sys_time<minutes> timestamp{minutes{timestamps[i]}};
+        sys_days day = floor<days>(timestamp);
+        if (bitmap.contains(day) || (day < firstRepresentableDay) || (day > lastRepresentableDay))
+        {
+            continue; // Classified already, or outside the calendar and never working time
+        }
+
+        if (!holidays)
+        {
+            holidays = getHolidays();
+        }
+        minutes minute = timestamp - day;
+        bool isWorking = !isWeekend(Date{day}) && !::isHoliday(*holidays, Date{day})
+                         && (minute >= start_.to_duration()) && (minute < stop_.to_duration());
+        workingMask[i / 64] |= static_cast<uint64_t>(isWorking) << (i % 64);
+    }
+}
+
+void WorkdayCalendar::setTimeZone(std::shared_ptr<const ZoneTransitionTable> zone)
+{
+    zone_ = std::move(zone);
+}
+
+PackedDateTime WorkdayCalendar::getUtcWorkdayIncrement(PackedDateTime utcStartDate,
+                                                       float incrementWorkdays)
+{
+    PackedDateTime result = 0;
+    getUtcWorkdayIncrements({&utcStartDate, 1}, {&incrementWorkdays, 1}, {&result, 1});
+    return result;
+}
+
+void WorkdayCalendar::getUtcWorkdayIncrements(std::span<const PackedDateTime> utcStartDates,
+                                              std::span<const float> incrementWorkdays,
+                                              std::span<PackedDateTime> utcResults,
+                                              BatchOrder order)
+{
+    size_t count = std::min({utcStartDates.size(), incrementWorkdays.size(), utcResults.size()});
+
+    // Working hours are local to the site, so the arithmetic itself runs on local time
+    std::span<const PackedDateTime> starts = utcStartDates.first(count);
+    std::vector<PackedDateTime> localStartDates{starts.begin(), starts.end()};
+    if (zone_)
+    {
+        zone_->toLocal(localStartDates);
+    }
+
+    getWorkdayIncrements(localStartDates, incrementWorkdays, utcResults, order);
+
+    if (zone_)
+    {
+        zone_->toUtc(utcResults.first(count));
+    }
+}
+
+minutes WorkdayCalendar::getWorkdayLength(void) const
+{
+    return duration_cast<minutes>(stop_.to_duration() - start_.to_duration());
+}
+
+WorkdayBitmap WorkdayCalendar::compile(Date firstDay, Date lastDay) const
+{
+    WorkdayBitmap result{sys_days{firstDay}, sys_days{lastDay}};
+
+    for (sys_days d = result.getFirstDay(); d <= result.getLastDay(); d += days{1})
+    {
+        result.setWorkday(d, !isWeekend(Date{d}));
+    }
+
+    clearHolidays(result,
+                  {.nonRecurring = nonRecurringHolidays_,
+                   .recurring = recurringHolidays_,
+                   .shared = sharedHolidays_.get()});
+
+    return result;
+}
+
+void WorkdayCalendar::buildIndex(Date firstDay, Date lastDay)
+{
+    index_ = std::make_shared<WorkdayIndex>(compile(firstDay, lastDay));
+}
+
+CompressedWorkdayTable WorkdayCalendar::compress(void) const
+{
+    HolidaySet holidays = getHolidays();
+    return CompressedWorkdayTable{
+        CompressedWorkdayTable::mondayToFriday, holidays.recurring, holidays.nonRecurring};
+}
+
+void WorkdayCalendar::buildCompressedTable(void)
+{
+    compressed_ = std::make_shared<const CompressedWorkdayTable>(compress());
+}
+
+SlaClock WorkdayCalendar::makeSlaClock(Date firstDay, Date lastDay) const
+{
+    // A built index already holds the compiled days, copying them beats compiling again
+    if (index_ && index_->contains(sys_days{firstDay}) && index_->contains(sys_days{lastDay}))
+    {
+        return SlaClock{index_->getBitmap(), start_, stop_};
+    }
+
+    return SlaClock{compile(firstDay, lastDay), start_, stop_};
+}
+
+bool WorkdayCalendar::isHolidayFree(void) const
+{
+    bool hasSharedHolidays = sharedHolidays_
+                             && !(sharedHolidays_->nonRecurring.empty()
+                                  && sharedHolidays_->recurring.empty());
+    return nonRecurringHolidays_.empty() && recurringHolidays_.empty() && !hasSharedHolidays;
+}
+
+HolidaySet WorkdayCalendar::getHolidays(void) const
+{
+    std::vector<Date> nonRecurring = nonRecurringHolidays_;
+    std::vector<Date> recurring = recurringHolidays_;
+    if (sharedHolidays_)
+    {
+        nonRecurring.insert(nonRecurring.end(),
+                            sharedHolidays_->nonRecurring.begin(),
+                            sharedHolidays_->nonRecurring.end());
+        recurring.insert(
+            recurring.end(), sharedHolidays_->recurring.begin(), sharedHolidays_->recurring.end());
+    }
+
+    return makeHolidaySet(nonRecurring, recurring);
+}
+
+WorkdayCalendar WorkdayCalendar::replicate(void) const
+{
+    // A deep copy, so every table is allocated and first written by the calling thread
+    WorkdayCalendar replica{};
+    replica.start_ = start_;
+    replica.stop_ = stop_;
+    replica.nonRecurringHolidays_ = nonRecurringHolidays_;
+    replica.recurringHolidays_ = recurringHolidays_;
+    if (sharedHolidays_)
+    {
+        replica.sharedHolidays_ = std::make_shared<const HolidaySet>(*sharedHolidays_);
+    }
+    if (index_)
+    {
+        replica.index_ = std::make_shared<WorkdayIndex>(*index_);
+    }
+    if (compressed_)
+    {
+        replica.compressed_ = std::make_shared<const CompressedWorkdayTable>(*compressed_);
+    }
+    if (zone_)
+    {
+        replica.zone_ = std::make_shared<const ZoneTransitionTable>(*zone_);
+    }
+
+    return replica;
+}
+
+void WorkdayCalendar::shareHolidays(std::shared_ptr<const HolidaySet> holidays,
+                                    std::shared_ptr<WorkdayIndex> index)
+{
+    nonRecurringHolidays_.clear();
+    nonRecurringHolidays_.shrink_to_fit();
+    recurringHolidays_.clear();
+    recurringHolidays_.shrink_to_fit();
+    sharedHolidays_ = std::move(holidays);
+    index_ = std::move(index);
+}
+
+void WorkdayCalendar::detachSharedHolidays(void)
+{
+    if (!sharedHolidays_)
+    {
+        return;
+    }
+
+    // Removing a day may hit the shared set, so take a private copy first
+    nonRecurringHolidays_.insert(nonRecurringHolidays_.end(),
+                                 sharedHolidays_->nonRecurring.begin(),
+                                 sharedHolidays_->nonRecurring.end());
+    recurringHolidays_.insert(recurringHolidays_.end(),
+                              sharedHolidays_->recurring.begin(),
+                              sharedHolidays_->recurring.end());
+    sharedHolidays_.reset();
+}
+
+WorkdayIndex &WorkdayCalendar::getMutableIndex(void)
+{
+    // Only exact while no other thread copies a calendar sharing the index, see the class docs
+    if (index_.use_count() > 1)
+    {
+        index_ = std::make_shared<WorkdayIndex>(*index_);
+    }
+
+    return *index_;
+}
+
+void WorkdayCalendar::refreshIndex(Date date, bool isRecurring)
+{
+    if (!index_)
+    {
+        return;
+    }
+
+    Holidays holidays{.nonRecurring = nonRecurringHolidays_,
+                      .recurring = recurringHolidays_,
+                      .shared = sharedHolidays_.get()};
+    auto [firstYear, lastYear] = getIndexedYears(date, isRecurring);
+    for (year y = firstYear; y <= lastYear; ++y)
+    {
+        Date occurrence{y, date.month(), date.day()};
+        if (occurrence.ok() && index_->contains(sys_days{occurrence}))
+        {
+            bool isWorking = !isWeekend(occurrence) && !isHoliday(occurrence, holidays);
+            if (index_->isWorkday(sys_days{occurrence}) != isWorking)
+            {
+                getMutableIndex().setWorkday(sys_days{occurrence}, isWorking);
+            }
+        }
+    }
+}
+
+void WorkdayCalendar::markIndexedHoliday(Date date, bool isRecurring)
+{
+    if (!index_)
+    {
+        return;
+    }
+
+    // A new holiday can only turn days off, no need to look at the other holidays
+    auto [firstYear, lastYear] = getIndexedYears(date, isRecurring);
+    for (year y = firstYear; y <= lastYear; ++y)
+    {
+        Date occurrence{y, date.month(), date.day()};
+        if (occurrence.ok() && index_->contains(sys_days{occurrence})
+            && index_->isWorkday(sys_days{occurrence}))
+        {
+            getMutableIndex().setWorkday(sys_days{occurrence}, false);
+        }
+    }
+}
+
+void WorkdayCalendar::refreshCompressedTable(void)
+{
+    // The table is a handful of rules, rebuilding it is cheaper than patching it
+    if (compressed_)
+    {
+        buildCompressedTable();
+    }
+}
+
+std::pair<year, year> WorkdayCalendar::getIndexedYears(Date date, bool isRecurring) const
+{
+    // A recurring change touches the same month and day in every indexed year
+    if (!isRecurring)
+    {
+        return {date.year(), date.year()};
+    }
+
+    return {Date{index_->getBitmap().getFirstDay()}.year(),
+            Date{index_->getBitmap().getLastDay()}.year()};
+}
+
+namespace
+{
+template <int Sign, bool IsHolidayFree, bool IsWholeDay>
+DateTime incrementKernel(DateTime startDate,
+                         float incrementWorkdays,
+                         const IncrementContext &context)
 {
     DateTime result{};
-    Holidays holidays{.nonRecurring = nonRecurringHolidays_, .recurring = recurringHolidays_};
 
-    days increment = calculateIncrement(incrementWorkdays);
-    WorkdayDurationsInMinutes timeInMinutes
-        = calculateTimeDuration(startDate.time, incrementWorkdays, start_, stop_);
+    WorkdayDurationsInMinutes timeInMinutes{};
+    if constexpr (IsWholeDay)
+    {
+        // Nothing to spread over the working hours, skip the floating point part
+        timeInMinutes.startWorkday = duration_cast<minutes>(context.startWorkday.to_duration());
+        timeInMinutes.stopWorkday = duration_cast<minutes>(context.stopWorkday.to_duration());
+        timeInMinutes.inputTime = duration_cast<minutes>(startDate.time.to_duration());
+    }
+    else
+    {
+        timeInMinutes = calculateTimeDuration(
+            startDate.time, incrementWorkdays, context.startWorkday, context.stopWorkday);
+    }
 
     auto correctedStartTime = clampStartTime(timeInMinutes);
     auto timePoint = makeTimepoint(startDate);
     result.time = calculateEndTime(correctedStartTime, timePoint, timeInMinutes);
 
-    timePoint = clampStartDate(incrementWorkdays, timePoint, holidays);
-    result.date = calculateEndDate(incrementWorkdays, timePoint, holidays);
+    if constexpr (IsHolidayFree)
+    {
+        // Only weekends to skip, the date follows in closed form
+        sys_days day = clampToWeekday<Sign>(floor<days>(timePoint));
+        result.date = Date{addWeekdays<Sign>(day, static_cast<int32_t>(incrementWorkdays))};
+    }
+    else
+    {
+        std::optional<Date> indexedDate{};
+        if (context.index)
+        {
+            indexedDate = calculateEndDate(incrementWorkdays, timePoint, *context.index);
+        }
+        if (!indexedDate && context.compressed)
+        {
+            indexedDate = calculateEndDate(incrementWorkdays, timePoint, *context.compressed);
+        }
+
+        if (indexedDate)
+        {
+            result.date = *indexedDate;
+        }
+        else
+        {
+            timePoint = clampStartDate(incrementWorkdays, timePoint, context.holidays);
+            result.date = calculateEndDate(incrementWorkdays, timePoint, context.holidays);
+        }
+    }
 
     return result;
 }
 
-namespace
+template <int Sign>
+sys_days clampToWeekday(sys_days day)
+{
+    // ISO encoding: Monday is 1, Saturday 6 and Sunday 7
+    int32_t isoDay = static_cast<int32_t>(weekday{day}.iso_encoding());
+    int32_t weekendDays = std::max(isoDay - 5, 0);
+    if constexpr (Sign > 0)
+    {
+        return day + days{weekendDays ? 3 - weekendDays : 0};
+    }
+    else
+    {
+        return day - days{weekendDays};
+    }
+}
+
+template <int Sign>
+sys_days addWeekdays(sys_days day, int32_t workdays)
+{
+    // day is a weekday; count the distance to the end of the week in the walking direction
+    int32_t position = static_cast<int32_t>(weekday{day}.iso_encoding()) - 1;
+    if constexpr (Sign < 0)
+    {
+        position = 4 - position;
+        workdays = -workdays;
+    }
+
+    int32_t remainder = workdays % 5;
+    int32_t distance = (workdays / 5) * 7 + remainder + ((position + remainder >= 5) ? 2 : 0);
+
+    return day + days{Sign * distance};
+}
+
+IncrementKernel selectKernel(float incrementWorkdays, bool isHolidayFree)
+{
+    static constexpr IncrementKernel kernels[2][2][2] = {
+        {{incrementKernel<-1, false, false>, incrementKernel<-1, false, true>},
+         {incrementKernel<1, false, false>, incrementKernel<1, false, true>}},
+        {{incrementKernel<-1, true, false>, incrementKernel<-1, true, true>},
+         {incrementKernel<1, true, false>, incrementKernel<1, true, true>}}};
+
+    bool isForward = incrementWorkdays >= 0.0f;
+    bool isWholeDay = incrementWorkdays == std::trunc(incrementWorkdays);
+
+    return kernels[isHolidayFree][isForward][isWholeDay];
+}
+
+void sweepSortedBatch(std::span<const PackedDateTime> startDates,
+                      std::span<const float> incrementWorkdays,
+                      std::span<PackedDateTime> results,
+                      const WorkdayBitmap &bitmap,
+                      const IncrementContext &context)
+{
+    SweepCursor cursor{.words = bitmap.getWords(),
+                       .firstDay = bitmap.getFirstDay(),
+                       .lastDay = bitmap.getLastDay(),
+                       .word = 0,
+                       .rankBeforeWord = 0};
+
+    for (size_t i = 0; i < startDates.size(); ++i)
+    {
+        DateTime startDate = unpackDateTime(startDates[i]);
+        float increment = incrementWorkdays[i];
+
+        DateTime result{};
+        WorkdayDurationsInMinutes timeInMinutes = calculateTimeDuration(
+            startDate.time, increment, context.startWorkday, context.stopWorkday);
+        auto correctedStartTime = clampStartTime(timeInMinutes);
+        auto timePoint = makeTimepoint(startDate);
+        result.time = calculateEndTime(correctedStartTime, timePoint, timeInMinutes);
+
+        std::optional<sys_days> endDay = sweepEndDay(cursor, floor<days>(timePoint), increment);
+        if (endDay)
+        {
+            result.date = Date{*endDay};
+        }
+        else
+        {
+            result = selectKernel(increment, false)(startDate, increment, context);
+        }
+
+        results[i] = packDateTime(result);
+    }
+}
+
+std::optional<sys_days> sweepEndDay(SweepCursor &cursor, sys_days day, float incrementWorkdays)
+{
+    if ((day < cursor.firstDay) || (day > cursor.lastDay))
+    {
+        return std::nullopt;
+    }
+
+    // A non-working start day moves to the next working day forwards, which is one rank
+    // up, or to the previous one backwards, which already has the rank of the start day
+    int64_t rank = moveCursor(cursor, day);
+    int64_t offset = (day - cursor.firstDay).count();
+    bool isWorkday = (cursor.words[cursor.word] >> (offset % 64)) & 1u;
+    if (!isWorkday && (incrementWorkdays >= 0.0f))
+    {
+        ++rank;
+    }
+
+    return findByRank(cursor, rank + static_cast<int32_t>(incrementWorkdays));
+}
+
+int64_t moveCursor(SweepCursor &cursor, sys_days day)
+{
+    int64_t offset = (day - cursor.firstDay).count();
+    size_t word = static_cast<size_t>(offset / 64);
+
+    while (cursor.word < word)
+    {
+        cursor.rankBeforeWord += std::popcount(cursor.words[cursor.word]);
+        ++cursor.word;
+    }
+    while (cursor.word > word)
+    {
+        --cursor.word;
+        cursor.rankBeforeWord -= std::popcount(cursor.words[cursor.word]);
+    }
+
+    uint64_t upToDay = ~uint64_t{0} >> (63 - offset % 64);
+    return cursor.rankBeforeWord + std::popcount(cursor.words[cursor.word] & upToDay);
+}
+
+std::optional<sys_days> findByRank(SweepCursor cursor, int64_t rank)
 {
+    if (rank < 1)
+    {
+        return std::nullopt;
+    }
+
+    while (cursor.rankBeforeWord >= rank)
+    {
+        --cursor.word;
+        cursor.rankBeforeWord -= std::popcount(cursor.words[cursor.word]);
+    }
+    while (cursor.rankBeforeWord + std::popcount(cursor.words[cursor.word]) < rank)
+    {
+        cursor.rankBeforeWord += std::popcount(cursor.words[cursor.word]);
+        if (++cursor.word == cursor.words.size())
+        {
+            return std::nullopt;
+        }
+    }
+
+    uint64_t word = cursor.words[cursor.word];
+    for (int64_t skipped = cursor.rankBeforeWord + 1; skipped < rank; ++skipped)
+    {
+        word &= word - 1;
+    }
+
+    return cursor.firstDay
+           + days{static_cast<int64_t>(cursor.word) * 64 + std::countr_zero(word)};
+}
+
 WorkdayDurationsInMinutes calculateTimeDuration(Time startTime,
                                                 float incrementWorkdays,
                                                 Time startWorkday,
@@ -182,6 +866,38 @@ time_point<system_clock, minutes> clampStartDate(float incrementWorkdays,
     return timePoint;
 }
 
+template <typename Index>
+std::optional<Date> calculateEndDate(float incrementWorkdays,
+                                     time_point<system_clock, minutes> timePoint,
+                                     const Index &index)
+{
+    days increment = calculateIncrement(incrementWorkdays);
+    sys_days current = floor<days>(timePoint);
+    if (!index.contains(current))
+    {
+        return std::nullopt;
+    }
+
+    std::optional<sys_days> start{current};
+    if (!index.isWorkday(current))
+    {
+        start = index.findWorkday(current, static_cast<int32_t>(increment.count()));
+    }
+    if (!start)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<sys_days> result
+        = index.findWorkday(*start, static_cast<int32_t>(incrementWorkdays));
+    if (!result)
+    {
+        return std::nullopt;
+    }
+
+    return Date{*result};
+}
+
 time_point<system_clock, minutes> makeTimepoint(DateTime dt)
 {
     return (sys_days(dt.date) + dt.time.hours() + dt.time.minutes());
@@ -193,6 +909,45 @@ days calculateIncrement(float incrementWorkdays)
     return days{sign * 1};
 }
 
+void clearHolidays(WorkdayBitmap &bitmap, Holidays holidays)
+{
+    std::span<const Date> sharedNonRecurring{};
+    std::span<const Date> sharedRecurring{};
+    if (holidays.shared)
+    {
+        sharedNonRecurring = holidays.shared->nonRecurring;
+        sharedRecurring = holidays.shared->recurring;
+    }
+
+    for (std::span<const Date> list : {holidays.nonRecurring, sharedNonRecurring})
+    {
+        for (Date holiday : list)
+        {
+            if (holiday.ok() && bitmap.contains(sys_days{holiday}))
+            {
+                bitmap.setWorkday(sys_days{holiday}, false);
+            }
+        }
+    }
+
+    year firstYear = Date{bitmap.getFirstDay()}.year();
+    year lastYear = Date{bitmap.getLastDay()}.year();
+    for (std::span<const Date> list : {holidays.recurring, sharedRecurring})
+    {
+        for (Date holiday : list)
+        {
+            for (year y = firstYear; y <= lastYear; ++y)
+            {
+                Date occurrence{y, holiday.month(), holiday.day()};
+                if (occurrence.ok() && bitmap.contains(sys_days{occurrence}))
+                {
+                    bitmap.setWorkday(sys_days{occurrence}, false);
+                }
+            }
+        }
+    }
+}
+
 bool isWeekend(Date date)
 {
     weekday wd{date};
@@ -217,6 +972,11 @@ bool isHoliday(Date date, Holidays holidays)
             return true;
         }
     }
+
+    if (holidays.shared)
+    {
+        return ::isHoliday(*holidays.shared, date);
+    }
     return false;
 }
 } // namespace
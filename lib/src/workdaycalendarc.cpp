@@ -0,0 +1,261 @@
+#include "workdaycalendarc.h"
+#include "workdaycalendar.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <new>
+#include <span>
+#include <vector>
+
+using namespace std::chrono;
+
+struct WorkdayCalendarHandle
+{
+    WorkdayCalendar calendar;
+    bool isFrozen;
+};
+
+namespace
+{
+constexpr uint32_t minutesPerDay = 24 * 60;
+
+static_assert(WORKDAYCALENDAR_C_MAX_INCREMENT_WORKDAYS == maxIncrementWorkdays);
+
+template <typename Operation>
+WorkdayCalendarStatus guard(Operation operation);
+WorkdayCalendarStatus checkMutable(const WorkdayCalendarHandle *calendar);
+bool isValidBatch(const void *input, const void *output, size_t count);
+bool areValidIncrements(const float *incrementWorkdays, size_t count);
+std::vector<Date> toDates(const int32_t *daysSinceEpoch, size_t count);
+} // namespace
+
+uint32_t workdayCalendarAbiVersion(void)
+{
+    return WORKDAYCALENDAR_C_ABI_VERSION;
+}
+
+WorkdayCalendarHandle *workdayCalendarCreate(void)
+{
+    return new (std::nothrow) WorkdayCalendarHandle{.calendar = {}, .isFrozen = false};
+}
+
+void workdayCalendarDestroy(WorkdayCalendarHandle *calendar)
+{
+    delete calendar;
+}
+
+WorkdayCalendarStatus workdayCalendarSetWorkingHours(WorkdayCalendarHandle *calendar,
+                                                     uint32_t startMinute,
+                                                     uint32_t stopMinute)
+{
+    if ((startMinute >= stopMinute) || (stopMinute >= minutesPerDay))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+    if (WorkdayCalendarStatus status = checkMutable(calendar); status != WorkdayCalendarOk)
+    {
+        return status;
+    }
+
+    Date anyDay{year{2000}, January, day{1}};
+    calendar->calendar.setWorkdayStartAndStop(
+        GregorianCalendar{DateTime{anyDay, Time{minutes{startMinute}}}},
+        GregorianCalendar{DateTime{anyDay, Time{minutes{stopMinute}}}});
+    return WorkdayCalendarOk;
+}
+
+WorkdayCalendarStatus workdayCalendarAddHolidays(WorkdayCalendarHandle *calendar,
+                                                 const int32_t *daysSinceEpoch,
+                                                 size_t count)
+{
+    if (WorkdayCalendarStatus status = checkMutable(calendar); status != WorkdayCalendarOk)
+    {
+        return status;
+    }
+    if (!isValidBatch(daysSinceEpoch, daysSinceEpoch, count))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] { calendar->calendar.setHolidays(toDates(daysSinceEpoch, count)); });
+}
+
+WorkdayCalendarStatus workdayCalendarAddRecurringHolidays(WorkdayCalendarHandle *calendar,
+                                                          const int32_t *daysSinceEpoch,
+                                                          size_t count)
+{
+    if (WorkdayCalendarStatus status = checkMutable(calendar); status != WorkdayCalendarOk)
+    {
+        return status;
+    }
+    if (!isValidBatch(daysSinceEpoch, daysSinceEpoch, count))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] { calendar->calendar.setRecurringHolidays(toDates(daysSinceEpoch, count)); });
+}
+
+WorkdayCalendarStatus workdayCalendarSetTimeZone(WorkdayCalendarHandle *calendar,
+                                                 int32_t initialOffset,
+                                                 const int64_t *transitionTimestamps,
+                                                 const int32_t *transitionOffsets,
+                                                 size_t count)
+{
+    if (WorkdayCalendarStatus status = checkMutable(calendar); status != WorkdayCalendarOk)
+    {
+        return status;
+    }
+    if (!isValidBatch(transitionTimestamps, transitionOffsets, count))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] {
+        std::vector<OffsetTransition> transitions(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            transitions[i] = {.utc = transitionTimestamps[i],
+                              .offset = minutes{transitionOffsets[i]}};
+        }
+        calendar->calendar.setTimeZone(
+            std::make_shared<const ZoneTransitionTable>(minutes{initialOffset}, transitions));
+    });
+}
+
+WorkdayCalendarStatus workdayCalendarFreeze(WorkdayCalendarHandle *calendar,
+                                            int32_t firstYear,
+                                            int32_t lastYear)
+{
+    if (WorkdayCalendarStatus status = checkMutable(calendar); status != WorkdayCalendarOk)
+    {
+        return status;
+    }
+    if ((firstYear > lastYear) || !year{firstYear}.ok() || !year{lastYear}.ok())
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] {
+        calendar->calendar.buildIndex(Date{year{firstYear}, January, day{1}},
+                                      Date{year{lastYear}, December, day{31}});
+        calendar->isFrozen = true;
+    });
+}
+
+WorkdayCalendarStatus workdayCalendarIncrements(WorkdayCalendarHandle *calendar,
+                                                const int64_t *startTimestamps,
+                                                const float *incrementWorkdays,
+                                                int64_t *results,
+                                                size_t count)
+{
+    if (!calendar || !isValidBatch(startTimestamps, results, count)
+        || !isValidBatch(incrementWorkdays, incrementWorkdays, count)
+        || !areValidIncrements(incrementWorkdays, count))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] {
+        calendar->calendar.getWorkdayIncrements({startTimestamps, count},
+                                                {incrementWorkdays, count},
+                                                {results, count});
+    });
+}
+
+WorkdayCalendarStatus workdayCalendarUtcIncrements(WorkdayCalendarHandle *calendar,
+                                                   const int64_t *startTimestamps,
+                                                   const float *incrementWorkdays,
+                                                   int64_t *results,
+                                                   size_t count)
+{
+    if (!calendar || !isValidBatch(startTimestamps, results, count)
+        || !isValidBatch(incrementWorkdays, incrementWorkdays, count)
+        || !areValidIncrements(incrementWorkdays, count))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] {
+        calendar->calendar.getUtcWorkdayIncrements({startTimestamps, count},
+                                                   {incrementWorkdays, count},
+                                                   {results, count});
+    });
+}
+
+WorkdayCalendarStatus workdayCalendarClassifyWorkingTime(const WorkdayCalendarHandle *calendar,
+                                                         const int64_t *timestamps,
+                                                         uint64_t *workingMask,
+                                                         size_t count)
+{
+    if (!calendar || !isValidBatch(timestamps, workingMask, count))
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return guard([&] {
+        calendar->calendar.classifyWorkingTime({timestamps, count},
+                                               {workingMask, (count + 63) / 64});
+    });
+}
+
+namespace
+{
+template <typename Operation>
+WorkdayCalendarStatus guard(Operation operation)
+{
+    // Nothing may unwind into the caller's language runtime
+    try
+    {
+        operation();
+    }
+    catch (const std::bad_alloc &)
+    {
+        return WorkdayCalendarOutOfMemory;
+    }
+    catch (const std::exception &)
+    {
+        return WorkdayCalendarInternalError;
+    }
+    catch (...)
+    {
+        return WorkdayCalendarInternalError;
+    }
+
+    return WorkdayCalendarOk;
+}
+
+WorkdayCalendarStatus checkMutable(const WorkdayCalendarHandle *calendar)
+{
+    if (!calendar)
+    {
+        return WorkdayCalendarInvalidArgument;
+    }
+
+    return calendar->isFrozen ? WorkdayCalendarFrozen : WorkdayCalendarOk;
+}
+
+bool isValidBatch(const void *input, const void *output, size_t count)
+{
+    return (count == 0) || (input && output);
+}
+
+bool areValidIncrements(const float *incrementWorkdays, size_t count)
+{
+    // NaN marks missing values in NumPy and Arrow arrays, it must not reach the day walk
+    return std::all_of(incrementWorkdays, incrementWorkdays + count, [](float increment) {
+        return std::isfinite(increment) && (std::abs(increment) <= maxIncrementWorkdays);
+    });
+}
+
+std::vector<Date> toDates(const int32_t *daysSinceEpoch, size_t count)
+{
+    std::vector<Date> result(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = Date{sys_days{days{daysSinceEpoch[i]}}};
+    }
+
+    return result;
+}
+} // namespace
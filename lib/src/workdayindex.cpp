@@ -0,0 +1,180 @@
+#include "workdayindex.h"
+#include <bit>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace
+{
+int64_t selectBit(uint64_t word, uint32_t n);
+} // namespace
+
+WorkdayIndex::WorkdayIndex(WorkdayBitmap bitmap) : bitmap_(std::move(bitmap))
+{
+    std::span<const uint64_t> words = bitmap_.getWords();
+    tree_.assign(words.size() + 1, 0);
+
+    // Linear-time Fenwick construction, each node pushes its sum to its parent
+    for (size_t i = 1; i < tree_.size(); ++i)
+    {
+        tree_[i] += static_cast<uint32_t>(std::popcount(words[i - 1]));
+        size_t parent = i + (i & (~i + 1));
+        if (parent < tree_.size())
+        {
+            tree_[parent] += tree_[i];
+        }
+    }
+}
+
+bool WorkdayIndex::contains(sys_days day) const
+{
+    return bitmap_.contains(day);
+}
+
+bool WorkdayIndex::isWorkday(sys_days day) const
+{
+    return bitmap_.isWorkday(day);
+}
+
+void WorkdayIndex::setWorkday(sys_days day, bool isWorking)
+{
+    if (bitmap_.isWorkday(day) == isWorking)
+    {
+        return;
+    }
+
+    bitmap_.setWorkday(day, isWorking);
+    size_t word = static_cast<size_t>((day - bitmap_.getFirstDay()).count()
+                                      / WorkdayBitmap::daysPerWord);
+    addToWord(word, isWorking ? 1 : -1);
+}
+
+uint32_t WorkdayIndex::countWorkdays(sys_days from, sys_days to) const
+{
+    if (from > to)
+    {
+        return 0;
+    }
+
+    return countUpTo(to) - countUpTo(from - days{1});
+}
+
+std::optional<sys_days> WorkdayIndex::findWorkday(sys_days from, int32_t workdays) const
+{
+    if (!contains(from))
+    {
+        return std::nullopt;
+    }
+
+    if (workdays >= 0)
+    {
+        return findNthWorkday(countUpTo(from) + static_cast<uint32_t>(workdays));
+    }
+
+    uint32_t before = countUpTo(from - days{1});
+    uint32_t backwards = static_cast<uint32_t>(-static_cast<int64_t>(workdays));
+    if (backwards > before)
+    {
+        return std::nullopt;
+    }
+
+    return findNthWorkday(before - backwards + 1);
+}
+
+const WorkdayBitmap &WorkdayIndex::getBitmap(void) const
+{
+    return bitmap_;
+}
+
+uint32_t WorkdayIndex::countUpTo(sys_days day) const
+{
+    if (day < bitmap_.getFirstDay())
+    {
+        return 0;
+    }
+    if (day > bitmap_.getLastDay())
+    {
+        day = bitmap_.getLastDay();
+    }
+
+    int64_t offset = (day - bitmap_.getFirstDay()).count();
+    size_t word = static_cast<size_t>(offset / WorkdayBitmap::daysPerWord);
+    int64_t bit = offset % WorkdayBitmap::daysPerWord;
+    uint64_t mask = ~uint64_t{0} >> (WorkdayBitmap::daysPerWord - 1 - bit);
+
+    return prefixOfWords(word)
+           + static_cast<uint32_t>(std::popcount(bitmap_.getWords()[word] & mask));
+}
+
+uint32_t WorkdayIndex::prefixOfWords(size_t numberOfWords) const
+{
+    uint32_t result = 0;
+    for (size_t i = numberOfWords; i > 0; i -= i & (~i + 1))
+    {
+        result += tree_[i];
+    }
+
+    return result;
+}
+
+void WorkdayIndex::addToWord(size_t word, int32_t delta)
+{
+    for (size_t i = word + 1; i < tree_.size(); i += i & (~i + 1))
+    {
+        tree_[i] = static_cast<uint32_t>(static_cast<int32_t>(tree_[i]) + delta);
+    }
+}
+
+std::optional<sys_days> WorkdayIndex::findNthWorkday(uint32_t n) const
+{
+    if (n == 0)
+    {
+        return std::nullopt;
+    }
+
+    // Fenwick descent: largest prefix of words whose count is still below n
+    size_t position = 0;
+    uint32_t remaining = n;
+    for (size_t step = std::bit_floor(tree_.size() - 1); step > 0; step >>= 1)
+    {
+        size_t next = position + step;
+        if (next < tree_.size() && tree_[next] < remaining)
+        {
+            position = next;
+            remaining -= tree_[next];
+        }
+    }
+
+    std::span<const uint64_t> words = bitmap_.getWords();
+    if (position >= words.size())
+    {
+        return std::nullopt;
+    }
+
+    int64_t bit = selectBit(words[position], remaining);
+    if (bit < 0)
+    {
+        return std::nullopt;
+    }
+
+    return bitmap_.getFirstDay()
+           + days{static_cast<int64_t>(position) * WorkdayBitmap::daysPerWord + bit};
+}
+
+namespace
+{
+int64_t selectBit(uint64_t word, uint32_t n)
+{
+    if (static_cast<uint32_t>(std::popcount(word)) < n)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 1; i < n; ++i)
+    {
+        word &= word - 1;
+    }
+
+    return std::countr_zero(word);
+}
+} // namespace
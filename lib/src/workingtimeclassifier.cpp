@@ -0,0 +1,153 @@
+#include "workingtimeclassifier.h"
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define WORKDAYCALENDAR_HAS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+using namespace std::chrono;
+
+namespace
+{
+constexpr int64_t minutesPerDay = 24 * 60;
+
+struct ClassifierTables
+{
+    const uint64_t *words;
+    int64_t firstDay;
+    int64_t numberOfDays;
+    int64_t startMinute;
+    int64_t stopMinute;
+};
+
+void classifyScalar(const ClassifierTables &tables,
+                    std::span<const PackedDateTime> timestamps,
+                    size_t first,
+                    std::span<uint64_t> workingMask);
+
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+size_t classifyAvx2(const ClassifierTables &tables,
+                    std::span<const PackedDateTime> timestamps,
+                    std::span<uint64_t> workingMask);
+#endif
+} // namespace
+
+void classifyWorkingTime(const WorkdayBitmap &bitmap,
+                         Time startWorkday,
+                         Time stopWorkday,
+                         std::span<const PackedDateTime> timestamps,
+                         std::span<uint64_t> workingMask)
+{
+    ClassifierTables tables{
+        .words = bitmap.getWords().data(),
+        .firstDay = bitmap.getFirstDay().time_since_epoch().count(),
+        .numberOfDays = (bitmap.getLastDay() - bitmap.getFirstDay()).count() + 1,
+        .startMinute = duration_cast<minutes>(startWorkday.to_duration()).count(),
+        .stopMinute = duration_cast<minutes>(stopWorkday.to_duration()).count()};
+
+    timestamps = timestamps.first(std::min(timestamps.size(), workingMask.size() * 64));
+    std::fill_n(workingMask.begin(), (timestamps.size() + 63) / 64, 0);
+
+    size_t done = 0;
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+    if (__builtin_cpu_supports("avx2"))
+    {
+        done = classifyAvx2(tables, timestamps, workingMask);
+    }
+#endif
+    classifyScalar(tables, timestamps, done, workingMask);
+}
+
+namespace
+{
+void classifyScalar(const ClassifierTables &tables,
+                    std::span<const PackedDateTime> timestamps,
+                    size_t first,
+                    std::span<uint64_t> workingMask)
+{
+    for (size_t i = first; i < timestamps.size(); ++i)
+    {
+        int64_t day = timestamps[i] / minutesPerDay;
+        int64_t minute = timestamps[i] % minutesPerDay;
+        day -= (minute < 0) ? 1 : 0;
+        minute += (minute < 0) ? minutesPerDay : 0;
+
+        uint64_t offset = static_cast<uint64_t>(day - tables.firstDay);
+        bool isInRange = offset < static_cast<uint64_t>(tables.numberOfDays);
+        bool isWorkday = isInRange && ((tables.words[offset / 64] >> (offset % 64)) & 1u);
+        bool isWorkingTime = (minute >= tables.startMinute) && (minute < tables.stopMinute);
+
+        workingMask[i / 64] |= static_cast<uint64_t>(isWorkday && isWorkingTime) << (i % 64);
+    }
+}
+
+#ifdef WORKDAYCALENDAR_HAS_AVX2_KERNEL
+__attribute__((target("avx2"))) size_t classifyAvx2(const ClassifierTables &tables,
+                                                    std::span<const PackedDateTime> timestamps,
+                                                    std::span<uint64_t> workingMask)
+{
+    // Four timestamps per step. Minute counts inside the bitmap are small, so they
+    // convert exactly to double (magic-number trick, AVX2 has no int64 conversion)
+    // and the day split is a floored division instead of a 64-bit integer division.
+    // Steps with a lane outside the bitmap go to the scalar code instead.
+    const __m256i beforeFirstMinute = _mm256_set1_epi64x(tables.firstDay * minutesPerDay - 1);
+    const __m256i afterLastMinute
+        = _mm256_set1_epi64x((tables.firstDay + tables.numberOfDays) * minutesPerDay);
+    const __m256d perDay = _mm256_set1_pd(static_cast<double>(minutesPerDay));
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0); // 2^52 + 2^51
+    const __m128i firstDay = _mm_set1_epi32(static_cast<int32_t>(tables.firstDay));
+    const __m128i numberOfDays = _mm_set1_epi32(static_cast<int32_t>(tables.numberOfDays));
+    const __m128i beforeStart = _mm_set1_epi32(static_cast<int32_t>(tables.startMinute) - 1);
+    const __m128i stop = _mm_set1_epi32(static_cast<int32_t>(tables.stopMinute));
+    const __m128i sixtyThree = _mm_set1_epi32(63);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const long long *words = reinterpret_cast<const long long *>(tables.words);
+
+    size_t count = timestamps.size() & ~size_t{3};
+    for (size_t i = 0; i < count; i += 4)
+    {
+        __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&timestamps[i]));
+        __m256i isInside = _mm256_and_si256(_mm256_cmpgt_epi64(packed, beforeFirstMinute),
+                                            _mm256_cmpgt_epi64(afterLastMinute, packed));
+        if (_mm256_movemask_pd(_mm256_castsi256_pd(isInside)) != 0xF)
+        {
+            classifyScalar(tables, timestamps.first(i + 4), i, workingMask);
+            continue;
+        }
+
+        __m256d asDouble = _mm256_sub_pd(
+            _mm256_castsi256_pd(_mm256_add_epi64(packed, _mm256_castpd_si256(magic))), magic);
+        __m256d dayAsDouble = _mm256_floor_pd(_mm256_div_pd(asDouble, perDay));
+        __m256d minuteAsDouble = _mm256_sub_pd(asDouble, _mm256_mul_pd(dayAsDouble, perDay));
+
+        __m128i offset = _mm_sub_epi32(_mm256_cvtpd_epi32(dayAsDouble), firstDay);
+        __m128i minute = _mm256_cvtpd_epi32(minuteAsDouble);
+
+        // Signed compares on the offset reject days before and after the bitmap
+        __m128i isInRange = _mm_andnot_si128(_mm_cmplt_epi32(offset, _mm_setzero_si128()),
+                                             _mm_cmplt_epi32(offset, numberOfDays));
+        __m128i isWorkingTime
+            = _mm_and_si128(_mm_cmpgt_epi32(minute, beforeStart), _mm_cmplt_epi32(minute, stop));
+
+        __m128i wordIndex = _mm_and_si128(_mm_srai_epi32(offset, 6), isInRange);
+        __m256i gathered = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+                                                       words,
+                                                       wordIndex,
+                                                       _mm256_cvtepi32_epi64(isInRange),
+                                                       8);
+        __m256i bit = _mm256_cvtepi32_epi64(_mm_and_si128(offset, sixtyThree));
+        __m256i isWorkday = _mm256_and_si256(_mm256_srlv_epi64(gathered, bit), one);
+
+        __m256i isWorking = _mm256_and_si256(
+            _mm256_cmpeq_epi64(isWorkday, one),
+            _mm256_cvtepi32_epi64(_mm_and_si128(isInRange, isWorkingTime)));
+        uint64_t flags = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(isWorking)));
+
+        workingMask[i / 64] |= flags << (i % 64);
+    }
+
+    return count;
+}
+#endif
+} // namespace
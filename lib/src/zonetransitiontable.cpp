@@ -0,0 +1,126 @@
+#include "zonetransitiontable.h"
+#include <algorithm>
+#include <iterator>
+
+#ifdef WORKDAYCALENDAR_HAS_TZDB
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#endif
+
+using namespace std::chrono;
+
+ZoneTransitionTable::ZoneTransitionTable(minutes initialOffset,
+                                         std::span<const OffsetTransition> transitions)
+{
+    std::vector<OffsetTransition> sorted{transitions.begin(), transitions.end()};
+    std::sort(sorted.begin(), sorted.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.utc < rhs.utc;
+    });
+
+    offsets_.push_back(initialOffset);
+    for (const OffsetTransition &transition : sorted)
+    {
+        // Abbreviation-only changes in the source data are not transitions here
+        if (transition.offset == offsets_.back())
+        {
+            continue;
+        }
+
+        // The jump shows up in local time once the larger of both offsets has passed, so
+        // times skipped by a forward jump keep the old offset and repeated times the first one
+        minutes larger = std::max(transition.offset, offsets_.back());
+        utcTransitions_.push_back(transition.utc);
+        localTransitions_.push_back(transition.utc + larger.count());
+        offsets_.push_back(transition.offset);
+    }
+}
+
+minutes ZoneTransitionTable::getOffset(PackedDateTime utc) const
+{
+    auto passed = std::upper_bound(utcTransitions_.begin(), utcTransitions_.end(), utc);
+    return offsets_[static_cast<size_t>(std::distance(utcTransitions_.begin(), passed))];
+}
+
+PackedDateTime ZoneTransitionTable::toLocal(PackedDateTime utc) const
+{
+    return utc + getOffset(utc).count();
+}
+
+PackedDateTime ZoneTransitionTable::toUtc(PackedDateTime local) const
+{
+    auto passed = std::upper_bound(localTransitions_.begin(), localTransitions_.end(), local);
+    size_t offset = static_cast<size_t>(std::distance(localTransitions_.begin(), passed));
+    return local - offsets_[offset].count();
+}
+
+void ZoneTransitionTable::toLocal(std::span<PackedDateTime> timestamps) const
+{
+    for (PackedDateTime &timestamp : timestamps)
+    {
+        timestamp = toLocal(timestamp);
+    }
+}
+
+void ZoneTransitionTable::toUtc(std::span<PackedDateTime> timestamps) const
+{
+    for (PackedDateTime &timestamp : timestamps)
+    {
+        timestamp = toUtc(timestamp);
+    }
+}
+
+#ifdef WORKDAYCALENDAR_HAS_TZDB
+ZoneTransitionTable ZoneTransitionTable::fromTimeZone(const time_zone &zone,
+                                                      year firstYear,
+                                                      year lastYear)
+{
+    sys_seconds windowStart{sys_days{firstYear / January / 1}};
+    sys_seconds windowEnd{sys_days{(lastYear + years{1}) / January / 1}};
+
+    sys_info info = zone.get_info(windowStart);
+    minutes initialOffset = duration_cast<minutes>(info.offset);
+    std::vector<OffsetTransition> transitions{};
+    while (info.end < windowEnd)
+    {
+        info = zone.get_info(info.end);
+        transitions.push_back({.utc = duration_cast<minutes>(info.begin.time_since_epoch()).count(),
+                               .offset = duration_cast<minutes>(info.offset)});
+    }
+
+    return ZoneTransitionTable{initialOffset, transitions};
+}
+
+std::shared_ptr<const ZoneTransitionTable> getZoneTransitionTable(std::string_view zoneName,
+                                                                  year firstYear,
+                                                                  year lastYear)
+{
+    using Key = std::tuple<std::string, int32_t, int32_t>;
+    static std::mutex mutex{};
+    static std::map<Key, std::shared_ptr<const ZoneTransitionTable>> tables{};
+
+    Key key{std::string{zoneName}, static_cast<int32_t>(firstYear), static_cast<int32_t>(lastYear)};
+    std::lock_guard lock{mutex};
+    if (auto found = tables.find(key); found != tables.end())
+    {
+        return found->second;
+    }
+
+    const time_zone *zone = nullptr;
+    try
+    {
+        zone = locate_zone(zoneName);
+    }
+    catch (const std::runtime_error &)
+    {
+        return nullptr;
+    }
+
+    auto table = std::make_shared<const ZoneTransitionTable>(
+        ZoneTransitionTable::fromTimeZone(*zone, firstYear, lastYear));
+    tables.emplace(std::move(key), table);
+    return table;
+}
+#endif
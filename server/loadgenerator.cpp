@@ -0,0 +1,232 @@
+#include "queryprotocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+struct LoadSettings
+{
+    std::string socketPath;
+    uint32_t connections = 4;
+    uint32_t requestsPerConnection = 100000;
+    uint32_t pipelineDepth = 64;
+    uint32_t calendars = 1;
+};
+
+struct ConnectionResult
+{
+    std::vector<nanoseconds> latencies{};
+    uint32_t errors = 0;
+};
+
+bool parseArguments(int argc, char **argv, LoadSettings &settings);
+int connectTo(const std::string &path);
+bool sendAll(int fd, const void *data, size_t size);
+ConnectionResult runConnection(const LoadSettings &settings, uint32_t seed);
+nanoseconds percentile(const std::vector<nanoseconds> &sorted, double fraction);
+} // namespace
+
+int main(int argc, char **argv)
+{
+    LoadSettings settings{};
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " <socket path> [connections] [requests per connection] [pipeline depth]"
+                     " [calendars]\n";
+        return 1;
+    }
+
+    std::vector<ConnectionResult> results(settings.connections);
+    std::vector<std::thread> workers{};
+    auto start = steady_clock::now();
+    for (uint32_t i = 0; i < settings.connections; ++i)
+    {
+        workers.emplace_back([&settings, &results, i] { results[i] = runConnection(settings, i); });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start);
+
+    std::vector<nanoseconds> latencies{};
+    uint32_t errors = 0;
+    for (const ConnectionResult &result : results)
+    {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+    }
+    if (latencies.empty())
+    {
+        std::cerr << "no responses received\n";
+        return 1;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto toMicroseconds = [](nanoseconds ns) { return duration<double, std::micro>(ns).count(); };
+    std::cout << latencies.size() << " responses, " << errors << " errors in "
+              << elapsed.count() << " s\n"
+              << "throughput: " << static_cast<double>(latencies.size()) / elapsed.count()
+              << " queries/s\n"
+              << "latency p50: " << toMicroseconds(percentile(latencies, 0.50)) << " us, p99: "
+              << toMicroseconds(percentile(latencies, 0.99))
+              << " us, max: " << toMicroseconds(latencies.back()) << " us\n";
+
+    return 0;
+}
+
+namespace
+{
+bool parseArguments(int argc, char **argv, LoadSettings &settings)
+{
+    if (argc < 2)
+    {
+        return false;
+    }
+
+    settings.socketPath = argv[1];
+    uint32_t *optional[] = {&settings.connections,
+                            &settings.requestsPerConnection,
+                            &settings.pipelineDepth,
+                            &settings.calendars};
+    for (int i = 2; i < argc && i - 2 < 4; ++i)
+    {
+        unsigned long value = 0;
+        try
+        {
+            value = std::stoul(argv[i]);
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        if (value > UINT32_MAX)
+        {
+            return false;
+        }
+        *optional[i - 2] = static_cast<uint32_t>(std::max(value, 1ul));
+    }
+
+    return true;
+}
+
+int connectTo(const std::string &path)
+{
+    sockaddr_un address{.sun_family = AF_UNIX, .sun_path = {}};
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool sendAll(int fd, const void *data, size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0)
+    {
+        ssize_t sent = write(fd, bytes, size);
+        if (sent <= 0)
+        {
+            return false;
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+
+    return true;
+}
+
+ConnectionResult runConnection(const LoadSettings &settings, uint32_t seed)
+{
+    ConnectionResult result{};
+    int fd = connectTo(settings.socketPath);
+    if (fd < 0)
+    {
+        result.errors = settings.requestsPerConnection;
+        return result;
+    }
+
+    std::mt19937 random{seed};
+    std::uniform_int_distribution<PackedDateTime> startDates{
+        packDateTime({Date{year{2000}, January, day{1}}, {}}),
+        packDateTime({Date{year{2030}, December, day{31}}, {}})};
+    std::uniform_real_distribution<float> increments{-50.0f, 50.0f};
+    std::uniform_int_distribution<uint32_t> calendarIds{0, settings.calendars - 1};
+
+    std::vector<steady_clock::time_point> sentAt(settings.requestsPerConnection);
+    result.latencies.reserve(settings.requestsPerConnection);
+
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    std::vector<char> input{};
+    char buffer[16 * 1024];
+    while (received < settings.requestsPerConnection)
+    {
+        // Keep the pipeline full, then wait for whatever came back
+        while (sent < settings.requestsPerConnection && sent - received < settings.pipelineDepth)
+        {
+            QueryRequest request{.requestId = sent,
+                                 .calendarId = calendarIds(random),
+                                 .startDate = startDates(random),
+                                 .incrementWorkdays = increments(random),
+                                 .reserved = 0};
+            sentAt[sent] = steady_clock::now();
+            if (!sendAll(fd, &request, sizeof(request)))
+            {
+                break;
+            }
+            ++sent;
+        }
+
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count <= 0)
+        {
+            break;
+        }
+        auto now = steady_clock::now();
+        input.insert(input.end(), buffer, buffer + count);
+
+        for (const QueryResponse &response : takeFrames<QueryResponse>(input))
+        {
+            if (response.status != QueryStatus::Ok || response.requestId >= sent)
+            {
+                ++result.errors;
+            }
+            else
+            {
+                result.latencies.push_back(now - sentAt[response.requestId]);
+            }
+            ++received;
+        }
+    }
+
+    result.errors += settings.requestsPerConnection - received;
+    close(fd);
+    return result;
+}
+
+nanoseconds percentile(const std::vector<nanoseconds> &sorted, double fraction)
+{
+    size_t position = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[position];
+}
+} // namespace
@@ -0,0 +1,92 @@
+#pragma once
+#include "commoncalendar.h"
+#include "workdaycalendar.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/*
+ * Fixed-size native-endian frames exchanged over the local socket. A client
+ * may pipeline any number of requests; responses carry the request id back
+ * and can arrive in a different order than the requests were sent.
+ */
+struct QueryRequest
+{
+    uint32_t requestId;
+    uint32_t calendarId;
+    PackedDateTime startDate;
+    float incrementWorkdays;
+    uint32_t reserved;
+};
+
+enum class QueryStatus : uint32_t
+{
+    Ok = 0,
+    UnknownCalendar = 1,
+    InvalidArgument = 2
+};
+
+struct QueryResponse
+{
+    uint32_t requestId;
+    QueryStatus status;
+    PackedDateTime result;
+};
+
+static_assert(sizeof(QueryRequest) == 24);
+static_assert(sizeof(QueryResponse) == 16);
+
+/**
+ * @brief Takes every complete frame off the front of a receive buffer
+ *
+ * A trailing partial frame stays in input until the rest arrives.
+ *
+ */
+template <typename Frame>
+std::vector<Frame> takeFrames(std::vector<char> &input)
+{
+    size_t complete = input.size() / sizeof(Frame);
+    std::vector<Frame> frames(complete);
+    if (complete > 0)
+    {
+        std::memcpy(frames.data(), input.data(), complete * sizeof(Frame));
+        input.erase(input.begin(),
+                    input.begin() + static_cast<std::ptrdiff_t>(complete * sizeof(Frame)));
+    }
+
+    return frames;
+}
+
+/**
+ * @brief Appends one frame to a send buffer
+ *
+ */
+template <typename Frame>
+void appendFrame(const Frame &frame, std::vector<char> &output)
+{
+    const char *bytes = reinterpret_cast<const char *>(&frame);
+    output.insert(output.end(), bytes, bytes + sizeof(Frame));
+}
+
+/**
+ * @brief Rejects requests that would stall the single-threaded server
+ *
+ * Increments must be finite and no larger than maxIncrementWorkdays.
+ *
+ */
+inline QueryStatus checkRequest(const QueryRequest &request, size_t numberOfCalendars)
+{
+    if (request.calendarId >= numberOfCalendars)
+    {
+        return QueryStatus::UnknownCalendar;
+    }
+    if (!std::isfinite(request.incrementWorkdays)
+        || (std::abs(request.incrementWorkdays) > maxIncrementWorkdays))
+    {
+        return QueryStatus::InvalidArgument;
+    }
+
+    return QueryStatus::Ok;
+}
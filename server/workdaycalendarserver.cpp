@@ -0,0 +1,380 @@
+#include "holidayimporter.h"
+#include "queryprotocol.h"
+#include "workdaycalendar.h"
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+struct Connection
+{
+    std::vector<char> input{};
+    std::vector<char> output{};
+};
+
+struct PendingQuery
+{
+    int fd;
+    QueryRequest request;
+};
+
+struct ServerStatistics
+{
+    uint64_t batches;
+    uint64_t queries;
+    size_t largestBatch;
+};
+
+// Level-triggered epoll reports the rest of a flood on the next wake-up
+constexpr size_t maxReadPerWakeup = 1 << 20;
+// A client which stops reading its responses is dropped beyond this backlog
+constexpr size_t maxPendingOutput = 4 << 20;
+
+volatile std::sig_atomic_t isRunning = 1;
+
+void stop(int);
+bool loadCalendar(const std::string &path, WorkdayCalendar &calendar);
+int openListeningSocket(const std::string &path);
+void setNonBlocking(int fd);
+void acceptConnections(int listener, int epoll, std::unordered_map<int, Connection> &connections);
+bool readRequests(int fd, Connection &connection, std::vector<PendingQuery> &batch);
+void evaluateBatch(std::vector<PendingQuery> &batch,
+                   std::vector<WorkdayCalendar> &calendars,
+                   std::unordered_map<int, Connection> &connections);
+bool writeResponses(int fd, Connection &connection, int epoll);
+void closeConnection(int fd, int epoll, std::unordered_map<int, Connection> &connections);
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <socket path> [holidays.csv|holidays.ics ...]\n";
+        return 1;
+    }
+
+    // Calendar ids are the position of the holiday file on the command line
+    std::vector<WorkdayCalendar> calendars(static_cast<size_t>(std::max(argc - 2, 1)));
+    for (size_t i = 0; i < calendars.size(); ++i)
+    {
+        using namespace std::chrono;
+        calendars[i].setWorkdayStartAndStop(GregorianCalendar{2000, January, 1, 8, 0},
+                                            GregorianCalendar{2000, January, 1, 16, 0});
+        if ((argc > 2) && !loadCalendar(argv[i + 2], calendars[i]))
+        {
+            std::cerr << "cannot read " << argv[i + 2] << "\n";
+            return 1;
+        }
+        calendars[i].buildIndex(Date{year{1970}, January, day{1}},
+                                Date{year{2100}, December, day{31}});
+    }
+
+    int listener = openListeningSocket(argv[1]);
+    if (listener < 0)
+    {
+        std::cerr << "cannot listen on " << argv[1] << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int epoll = epoll_create1(0);
+    epoll_event listenerEvent{.events = EPOLLIN, .data = {.fd = listener}};
+    epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &listenerEvent);
+
+    std::unordered_map<int, Connection> connections{};
+    std::vector<PendingQuery> batch{};
+    std::vector<epoll_event> events(256);
+    ServerStatistics statistics{};
+
+    while (isRunning)
+    {
+        int ready = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), 100);
+
+        // Everything that arrived in one wake-up is evaluated as one micro-batch
+        for (int i = 0; i < ready; ++i)
+        {
+            int fd = events[static_cast<size_t>(i)].data.fd;
+            uint32_t flags = events[static_cast<size_t>(i)].events;
+            if (fd == listener)
+            {
+                acceptConnections(listener, epoll, connections);
+                continue;
+            }
+
+            bool isOpen = !(flags & (EPOLLHUP | EPOLLERR));
+            if (isOpen && (flags & EPOLLIN))
+            {
+                isOpen = readRequests(fd, connections[fd], batch);
+            }
+            if (isOpen && (flags & EPOLLOUT))
+            {
+                isOpen = writeResponses(fd, connections[fd], epoll);
+            }
+            if (!isOpen)
+            {
+                std::erase_if(batch, [fd](const PendingQuery &query) { return query.fd == fd; });
+                closeConnection(fd, epoll, connections);
+            }
+        }
+
+        if (batch.empty())
+        {
+            continue;
+        }
+
+        ++statistics.batches;
+        statistics.queries += batch.size();
+        statistics.largestBatch = std::max(statistics.largestBatch, batch.size());
+        evaluateBatch(batch, calendars, connections);
+        batch.clear();
+
+        std::vector<int> closed{};
+        for (auto &[fd, connection] : connections)
+        {
+            if (!connection.output.empty()
+                && (!writeResponses(fd, connection, epoll)
+                    || (connection.output.size() > maxPendingOutput)))
+            {
+                closed.push_back(fd);
+            }
+        }
+        for (int fd : closed)
+        {
+            closeConnection(fd, epoll, connections);
+        }
+    }
+
+    for (auto &[fd, connection] : connections)
+    {
+        close(fd);
+    }
+    close(listener);
+    close(epoll);
+    unlink(argv[1]);
+
+    std::cout << statistics.queries << " queries in " << statistics.batches
+              << " batches, largest batch " << statistics.largestBatch << "\n";
+    return 0;
+}
+
+namespace
+{
+void stop(int)
+{
+    isRunning = 0;
+}
+
+bool loadCalendar(const std::string &path, WorkdayCalendar &calendar)
+{
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+    {
+        return false;
+    }
+
+    std::stringstream content{};
+    content << file.rdbuf();
+    std::string buffer = content.str();
+    if (path.ends_with(".ics"))
+    {
+        importIcsHolidays(buffer, calendar);
+    }
+    else
+    {
+        importCsvHolidays(buffer, calendar);
+    }
+
+    return true;
+}
+
+int openListeningSocket(const std::string &path)
+{
+    sockaddr_un address{.sun_family = AF_UNIX, .sun_path = {}};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    unlink(path.c_str());
+    if ((bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+        || (listen(fd, SOMAXCONN) < 0))
+    {
+        close(fd);
+        return -1;
+    }
+    setNonBlocking(fd);
+
+    return fd;
+}
+
+void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+void acceptConnections(int listener, int epoll, std::unordered_map<int, Connection> &connections)
+{
+    int fd = -1;
+    while ((fd = accept(listener, nullptr, nullptr)) >= 0)
+    {
+        setNonBlocking(fd);
+        epoll_event event{.events = EPOLLIN, .data = {.fd = fd}};
+        epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+        connections[fd] = Connection{};
+    }
+}
+
+bool readRequests(int fd, Connection &connection, std::vector<PendingQuery> &batch)
+{
+    char buffer[64 * 1024];
+    size_t total = 0;
+    while (total < maxReadPerWakeup)
+    {
+        ssize_t received = read(fd, buffer, sizeof(buffer));
+        if (received == 0)
+        {
+            return false;
+        }
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                return false;
+            }
+            break;
+        }
+        connection.input.insert(connection.input.end(), buffer, buffer + received);
+        total += static_cast<size_t>(received);
+    }
+
+    // Only a partial frame is left behind, so the input buffer stays below one request
+    for (const QueryRequest &request : takeFrames<QueryRequest>(connection.input))
+    {
+        batch.push_back(PendingQuery{.fd = fd, .request = request});
+    }
+
+    return true;
+}
+
+void evaluateBatch(std::vector<PendingQuery> &batch,
+                   std::vector<WorkdayCalendar> &calendars,
+                   std::unordered_map<int, Connection> &connections)
+{
+    std::stable_sort(batch.begin(), batch.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.request.calendarId < rhs.request.calendarId;
+    });
+
+    std::vector<PackedDateTime> startDates{};
+    std::vector<float> increments{};
+    std::vector<PackedDateTime> results{};
+    std::vector<QueryStatus> statuses{};
+
+    for (size_t first = 0; first < batch.size();)
+    {
+        uint32_t calendarId = batch[first].request.calendarId;
+        size_t last = first;
+        while (last < batch.size() && batch[last].request.calendarId == calendarId)
+        {
+            ++last;
+        }
+
+        // Rejected queries never reach the calendar, one bad frame must not stall every client
+        startDates.clear();
+        increments.clear();
+        statuses.clear();
+        for (size_t i = first; i < last; ++i)
+        {
+            statuses.push_back(checkRequest(batch[i].request, calendars.size()));
+            if (statuses.back() == QueryStatus::Ok)
+            {
+                startDates.push_back(batch[i].request.startDate);
+                increments.push_back(batch[i].request.incrementWorkdays);
+            }
+        }
+        results.resize(startDates.size());
+        if (!startDates.empty())
+        {
+            calendars[calendarId].getWorkdayIncrements(startDates, increments, results);
+        }
+
+        size_t evaluated = 0;
+        for (size_t i = first; i < last; ++i)
+        {
+            QueryStatus status = statuses[i - first];
+            PackedDateTime result = (status == QueryStatus::Ok) ? results[evaluated++] : 0;
+            QueryResponse response{.requestId = batch[i].request.requestId,
+                                   .status = status,
+                                   .result = result};
+            appendFrame(response, connections[batch[i].fd].output);
+        }
+
+        first = last;
+    }
+}
+
+bool writeResponses(int fd, Connection &connection, int epoll)
+{
+    size_t written = 0;
+    while (written < connection.output.size())
+    {
+        ssize_t sent = write(
+            fd, connection.output.data() + written, connection.output.size() - written);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                return false;
+            }
+            break;
+        }
+        written += static_cast<size_t>(sent);
+    }
+    connection.output.erase(connection.output.begin(),
+                            connection.output.begin() + static_cast<std::ptrdiff_t>(written));
+
+    // Only ask for writability while there is a backlog, otherwise epoll spins
+    uint32_t flags = connection.output.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+    epoll_event event{.events = flags, .data = {.fd = fd}};
+    epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event);
+
+    return true;
+}
+
+void closeConnection(int fd, int epoll, std::unordered_map<int, Connection> &connections)
+{
+    epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
+} // namespace
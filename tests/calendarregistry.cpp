@@ -0,0 +1,85 @@
+#include "calendarregistry.h"
+#include "testcalendars.h"
+#include "gtest/gtest.h"
+
+TEST(CalendarRegistry, identicalHolidays_internedOnce)
+{
+    using namespace std::chrono;
+    // Arrange
+    CalendarRegistry registry{Date{year{2000}, January, day{1}},
+                              Date{year{2010}, December, day{31}}};
+    WorkdayCalendar reordered{};
+    reordered.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    reordered.setRecurringHoliday(GregorianCalendar{1990, May, 17, 0, 0});
+    reordered.setRecurringHoliday(GregorianCalendar{1990, May, 17, 0, 0});
+
+    // Act
+    WorkdayCalendar first = registry.intern(makeExampleCalendar());
+    WorkdayCalendar second = registry.intern(reordered);
+    WorkdayCalendar other = registry.intern(WorkdayCalendar{});
+
+    // Assert
+    EXPECT_EQ(registry.getNumberOfHolidaySets(), 2u);
+    EXPECT_EQ(first.getHolidays(), second.getHolidays());
+    EXPECT_NE(first.getHolidays(), other.getHolidays());
+}
+
+TEST(CalendarRegistry, internedCalendar_sameResultAsDefinition)
+{
+    using namespace std::chrono;
+    // Arrange
+    CalendarRegistry registry{Date{year{2000}, January, day{1}},
+                              Date{year{2010}, December, day{31}}};
+    WorkdayCalendar definition = makeExampleCalendar();
+    WorkdayCalendar interned = registry.intern(definition);
+    DateTime start = GregorianCalendar(2004, May, 24, 19, 3).getDateTime();
+
+    // Act
+    DateTime expected = definition.getWorkdayIncrement(start, 44.723656f);
+    DateTime result = interned.getWorkdayIncrement(start, 44.723656f);
+
+    // Assert
+    EXPECT_EQ(result.date, expected.date);
+    EXPECT_EQ(result.time.to_duration(), expected.time.to_duration());
+}
+
+TEST(CalendarRegistry, tenantDelta_doesNotLeakIntoOtherTenants)
+{
+    using namespace std::chrono;
+    // Arrange
+    CalendarRegistry registry{Date{year{2000}, January, day{1}},
+                              Date{year{2010}, December, day{31}}};
+    WorkdayCalendar tenantA = registry.intern(makeExampleCalendar());
+    WorkdayCalendar tenantB = registry.intern(makeExampleCalendar());
+    DateTime dt = {Date{year{2004}, June, day{1}}, {}};
+
+    // Act
+    tenantA.setHoliday(GregorianCalendar{2004, June, 2, 0, 0});
+    DateTime resultA = tenantA.getWorkdayIncrement(dt, 1.0f);
+    DateTime resultB = tenantB.getWorkdayIncrement(dt, 1.0f);
+
+    // Assert
+    EXPECT_EQ(resultA.date.day(), day{3});
+    EXPECT_EQ(resultB.date.day(), day{2});
+    EXPECT_EQ(registry.getNumberOfHolidaySets(), 1u);
+}
+
+TEST(CalendarRegistry, tenantRemovesSharedHoliday_otherTenantsKeepIt)
+{
+    using namespace std::chrono;
+    // Arrange
+    CalendarRegistry registry{Date{year{2000}, January, day{1}},
+                              Date{year{2010}, December, day{31}}};
+    WorkdayCalendar tenantA = registry.intern(makeExampleCalendar());
+    WorkdayCalendar tenantB = registry.intern(makeExampleCalendar());
+    DateTime dt = {Date{year{2004}, May, day{26}}, {}};
+
+    // Act
+    tenantA.removeHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    DateTime resultA = tenantA.getWorkdayIncrement(dt, 1.0f);
+    DateTime resultB = tenantB.getWorkdayIncrement(dt, 1.0f);
+
+    // Assert
+    EXPECT_EQ(resultA.date.day(), day{27});
+    EXPECT_EQ(resultB.date.day(), day{28});
+}
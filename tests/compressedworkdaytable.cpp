@@ -0,0 +1,96 @@
+#include "compressedworkdaytable.h"
+#include "testcalendars.h"
+#include "workdaycalendar.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+WorkdayCalendar makeCenturyCalendar(void)
+{
+    using namespace std::chrono;
+    WorkdayCalendar result = makeExampleCalendar();
+    std::vector<Date> recurring{Date{year{2000}, January, day{1}},
+                                Date{year{2000}, February, day{29}},
+                                Date{year{2000}, May, day{1}},
+                                Date{year{2000}, December, day{24}},
+                                Date{year{2000}, December, day{25}},
+                                Date{year{2000}, December, day{26}}};
+    result.setRecurringHolidays(recurring);
+    result.setHoliday(GregorianCalendar{1905, June, 7, 0, 0});
+    result.setHoliday(GregorianCalendar{2004, May, 29, 0, 0}); // Saturday, no exception
+    result.setHoliday(GregorianCalendar{2023, December, 25, 0, 0}); // Already recurring
+    return result;
+}
+} // namespace
+
+TEST(CompressedWorkdayTable, centuryCalendar_sameCountsAndStepsAsIndex)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc = makeCenturyCalendar();
+    Date firstDay{year{1900}, January, day{1}};
+    Date lastDay{year{2100}, December, day{31}};
+    WorkdayIndex index{wc.compile(firstDay, lastDay)};
+
+    // Act
+    CompressedWorkdayTable table = wc.compress();
+
+    // Assert
+    EXPECT_EQ(table.countWorkdays(sys_days{firstDay}, sys_days{lastDay}),
+              index.countWorkdays(sys_days{firstDay}, sys_days{lastDay}));
+    for (sys_days d = sys_days{Date{year{1903}, March, day{1}}};
+         d < sys_days{Date{year{2090}, January, day{1}}};
+         d += days{97})
+    {
+        ASSERT_EQ(table.isWorkday(d), index.isWorkday(d)) << d.time_since_epoch().count();
+        ASSERT_EQ(table.countWorkdays(d, d + days{3000}), index.countWorkdays(d, d + days{3000}))
+            << d.time_since_epoch().count();
+        for (int32_t workdays : {0, 1, -1, 17, -250, 700})
+        {
+            ASSERT_EQ(table.findWorkday(d, workdays), index.findWorkday(d, workdays))
+                << d.time_since_epoch().count() << " " << workdays;
+        }
+    }
+}
+
+TEST(CompressedWorkdayTable, centuryCalendar_fewHundredBytes)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc = makeCenturyCalendar();
+    WorkdayBitmap dense
+        = wc.compile(Date{year{1900}, January, day{1}}, Date{year{2100}, December, day{31}});
+
+    // Act
+    CompressedWorkdayTable table = wc.compress();
+
+    // Assert
+    EXPECT_LT(table.getMemoryUsage(), 1024u);
+    EXPECT_LT(table.getMemoryUsage() * 10, dense.getWords().size_bytes());
+}
+
+TEST(CompressedWorkdayTable, compressedCalendar_followsHolidayChanges)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar reference = makeCenturyCalendar();
+    WorkdayCalendar compressed = makeCenturyCalendar();
+    compressed.buildCompressedTable();
+    DateTime start = GregorianCalendar(1950, May, 24, 19, 3).getDateTime();
+
+    // Act
+    DateTime before = compressed.getWorkdayIncrement(start, 12000.5f);
+    compressed.setHoliday(GregorianCalendar{1950, May, 25, 0, 0});
+    reference.setHoliday(GregorianCalendar{1950, May, 25, 0, 0});
+    DateTime after = compressed.getWorkdayIncrement(start, 12000.5f);
+    DateTime expected = reference.getWorkdayIncrement(start, 12000.5f);
+    DateTime backwards = compressed.getWorkdayIncrement(start, -9000.25f);
+    DateTime expectedBackwards = reference.getWorkdayIncrement(start, -9000.25f);
+
+    // Assert
+    EXPECT_NE(before.date, after.date);
+    EXPECT_EQ(after.date, expected.date);
+    EXPECT_EQ(after.time.to_duration(), expected.time.to_duration());
+    EXPECT_EQ(backwards.date, expectedBackwards.date);
+    EXPECT_EQ(backwards.time.to_duration(), expectedBackwards.time.to_duration());
+}
@@ -1,5 +1,7 @@
 #include "gregoriancalendar.h"
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 
 TEST(GregorianCalendar, simpleConstruction_createSuccessfull)
 {
@@ -71,8 +73,8 @@ TEST(GregorianCalendar, todaysDate_createSuccessfull)
     minutes mm = hhmm.minutes();
 
     // Act
-    int16_t year = static_cast<int>(y);
-    uint8_t day = static_cast<unsigned int>(d);
+    int16_t year = static_cast<int16_t>(static_cast<int>(y));
+    uint8_t day = static_cast<uint8_t>(static_cast<unsigned int>(d));
     Month month = static_cast<Month>(static_cast<unsigned int>(m));
 
     uint8_t hour = static_cast<uint8_t>(hh.count());
@@ -167,6 +169,73 @@ INSTANTIATE_TEST_SUITE_P(AprilJuneSeptemberNovember,
                                          std::chrono::September,
                                          std::chrono::November));
 
+TEST(GregorianCalendar, packDateTimes_flagsAndClampsInvalidFields)
+{
+    using namespace std::chrono;
+    // Arrange
+    std::vector<int16_t> years{2024, 2023, 2025, 2025, 2025};
+    std::vector<uint8_t> months{2, 2, 13, 4, 6};
+    std::vector<uint8_t> days{29, 29, 10, 0, 15};
+    std::vector<uint8_t> hours{8, 8, 8, 8, 24};
+    std::vector<uint8_t> minutes{30, 30, 30, 30, 0};
+    std::vector<PackedDateTime> results(years.size());
+    std::vector<uint64_t> invalidMask(1);
+
+    // Act
+    size_t numberOfInvalid
+        = packDateTimes({years, months, days, hours, minutes}, results, invalidMask);
+
+    // Assert
+    EXPECT_EQ(numberOfInvalid, 4u);
+    EXPECT_EQ(invalidMask[0], 0b11110u);
+    EXPECT_EQ(results[0], packDateTime({Date{year{2024}, February, day{29}}, Time{8h + 30min}}));
+    EXPECT_EQ(results[1], packDateTime({Date{year{2023}, February, day{28}}, Time{8h + 30min}}));
+    EXPECT_EQ(results[2], packDateTime({Date{year{2025}, January, day{10}}, Time{8h + 30min}}));
+    EXPECT_EQ(results[3], packDateTime({Date{year{2025}, April, day{1}}, Time{8h + 30min}}));
+    EXPECT_EQ(results[4], packDateTime({Date{year{2025}, June, day{15}}, Time{23h + 59min}}));
+}
+
+TEST(GregorianCalendar, packDateTimes_matchesConstructor)
+{
+    using namespace std::chrono;
+    // Arrange
+    constexpr size_t count = 100000;
+    std::mt19937 random{38};
+    std::uniform_int_distribution<int> years{INT16_MIN, INT16_MAX};
+    std::uniform_int_distribution<int> fields{0, 255};
+    std::vector<int16_t> y(count);
+    std::vector<uint8_t> m(count), d(count), hh(count), mm(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Mostly plausible values, with the odd out of range field of any size
+        bool isWild = fields(random) < 16;
+        y[i] = static_cast<int16_t>(isWild ? years(random) : 1900 + fields(random));
+        m[i] = static_cast<uint8_t>(isWild ? fields(random) : fields(random) % 14);
+        d[i] = static_cast<uint8_t>(isWild ? fields(random) : fields(random) % 33);
+        hh[i] = static_cast<uint8_t>(isWild ? fields(random) : fields(random) % 25);
+        mm[i] = static_cast<uint8_t>(isWild ? fields(random) : fields(random) % 61);
+    }
+    y[0] = INT16_MIN;
+    std::vector<PackedDateTime> results(count);
+    std::vector<uint64_t> invalidMask((count + 63) / 64);
+
+    // Act
+    packDateTimes({y, m, d, hh, mm}, results, invalidMask);
+
+    // Assert
+    for (size_t i = 0; i < count; ++i)
+    {
+        GregorianCalendar gc{y[i], Month{m[i]}, d[i], hh[i], mm[i]};
+        bool isValid = Date{year{y[i]}, Month{m[i]}, day{d[i]}}.ok() && (hh[i] < 24)
+                    && (mm[i] < 60);
+        bool isFlagged = (invalidMask[i / 64] >> (i % 64)) & 1;
+        ASSERT_EQ(results[i], packDateTime(gc.getDateTime()))
+            << y[i] << "-" << +m[i] << "-" << +d[i] << " " << +hh[i] << ":" << +mm[i];
+        ASSERT_EQ(isFlagged, !isValid)
+            << y[i] << "-" << +m[i] << "-" << +d[i] << " " << +hh[i] << ":" << +mm[i];
+    }
+}
+
 /*
  * Additional tests covering months with 31 days, boundary years (minimum and maximum),
  * leap years, and other edge cases should be implemented to complete test coverage.
@@ -0,0 +1,221 @@
+#include "holidayimporter.h"
+#include "gtest/gtest.h"
+#include <string>
+
+TEST(HolidayImporter, icsSingleDayEvents_importedAsHolidays)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "BEGIN:VCALENDAR\r\n"
+                           "BEGIN:VEVENT\r\n"
+                           "DTSTART;VALUE=DATE:20040527\r\n"
+                           "DTEND;VALUE=DATE:20040528\r\n"
+                           "SUMMARY:Company day\r\n"
+                           "END:VEVENT\r\n"
+                           "END:VCALENDAR\r\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+    DateTime result = wc.getWorkdayIncrement({Date{year{2004}, May, day{26}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 1u);
+    EXPECT_EQ(imported.recurringHolidays, 0u);
+    EXPECT_EQ(result.date.day(), day{28});
+}
+
+TEST(HolidayImporter, icsYearlyRule_importedAsRecurringHoliday)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "BEGIN:VEVENT\n"
+                           "DTSTART;VALUE=DATE:19140517\n"
+                           "RRULE:FREQ=YEARLY\n"
+                           "END:VEVENT\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+    DateTime result = wc.getWorkdayIncrement({Date{year{2023}, May, day{16}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(imported.recurringHolidays, 1u);
+    EXPECT_EQ(result.date.day(), day{18});
+}
+
+TEST(HolidayImporter, icsBoundedAndUnsupportedRules_expandedOrSkipped)
+{
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "BEGIN:VEVENT\n"
+                           "DTSTART;VALUE=DATE:20200601\n"
+                           "RRULE:FREQ=YEARLY;COUNT=3\n"
+                           "END:VEVENT\n"
+                           "BEGIN:VEVENT\n"
+                           "DTSTART;VALUE=DATE:20201126\n"
+                           "RRULE:FREQ=YEARLY;BYMONTH=11;BYDAY=4TH\n"
+                           "END:VEVENT\n"
+                           "BEGIN:VEVENT\n"
+                           "SUMMARY:No start\n"
+                           "END:VEVENT\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 3u);
+    EXPECT_EQ(imported.recurringHolidays, 0u);
+    EXPECT_EQ(imported.skipped, 2u);
+}
+
+TEST(HolidayImporter, icsLeapDayCount_countsOnlyExistingOccurrences)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "BEGIN:VEVENT\n"
+                           "DTSTART;VALUE=DATE:20240229\n"
+                           "RRULE:FREQ=YEARLY;COUNT=3\n"
+                           "END:VEVENT\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+    HolidaySet holidays = wc.getHolidays();
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 3u);
+    EXPECT_EQ(holidays.nonRecurring,
+              (std::vector<Date>{Date{year{2024}, February, day{29}},
+                                 Date{year{2028}, February, day{29}},
+                                 Date{year{2032}, February, day{29}}}));
+}
+
+TEST(HolidayImporter, icsDateTimeEvents_skipped)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "BEGIN:VEVENT\n"
+                           "DTSTART:20240517T090000Z\n"
+                           "DTEND:20240517T100000Z\n"
+                           "SUMMARY:Meeting\n"
+                           "END:VEVENT\n"
+                           "BEGIN:VEVENT\n"
+                           "DTSTART;TZID=Europe/Oslo:20240520T080000\n"
+                           "END:VEVENT\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+    DateTime result = wc.getWorkdayIncrement({Date{year{2024}, May, day{16}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 0u);
+    EXPECT_EQ(imported.skipped, 2u);
+    EXPECT_EQ(result.date.day(), day{17});
+}
+
+TEST(HolidayImporter, icsFoldedRuleRestatingStart_importedAsRecurringHoliday)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "BEGIN:VEVENT\r\n"
+                           "DTSTART;VALUE=DATE:20001225\r\n"
+                           "RRULE:FREQ=YEARLY;BYMONTH=12;\r\n"
+                           " BYMONTHDAY=25\r\n"
+                           "SUMMARY:Christmas Day\r\n"
+                           "END:VEVENT\r\n"
+                           "BEGIN:VEVENT\r\n"
+                           "DTSTART;VALUE=DATE:20001226\r\n"
+                           "RRULE:FREQ=YEARLY;BYMONTH=12;BYMONTHDAY=2\r\n"
+                           "\t6;COUNT=2\r\n"
+                           "END:VEVENT\r\n"
+                           "BEGIN:VEVENT\r\n"
+                           "DTSTART;VALUE=DATE:20000101\r\n"
+                           "RRULE:FREQ=YEARLY;BYMONTH=1,7;BYMONTHDAY=1\r\n"
+                           "END:VEVENT\r\n"
+                           "BEGIN:VEVENT\r\n"
+                           "DTSTART;VALUE=DATE:20000501\r\n"
+                           "RRULE:FREQ=YEARLY;BYMONTH=6\r\n"
+                           "END:VEVENT\r\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+    DateTime result = wc.getWorkdayIncrement({Date{year{2023}, December, day{22}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(imported.recurringHolidays, 1u);
+    EXPECT_EQ(imported.holidays, 2u);
+    EXPECT_EQ(imported.skipped, 2u);
+    EXPECT_EQ(result.date.day(), day{26});
+}
+
+TEST(HolidayImporter, icsStrayEndEvent_doesNotImportAgain)
+{
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view ics = "END:VEVENT\n"
+                           "BEGIN:VEVENT\n"
+                           "DTSTART;VALUE=DATE:20040527\n"
+                           "END:VEVENT\n"
+                           "END:VEVENT\n";
+
+    // Act
+    HolidayImportResult imported = importIcsHolidays(ics, wc);
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 1u);
+    EXPECT_EQ(imported.skipped, 0u);
+}
+
+TEST(HolidayImporter, csvWithHeader_importsDatesAndSkipsHeader)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    std::string_view csv = "date,name\n"
+                           "2004-05-27,Company day\n"
+                           "\"--05-17\",National day\n"
+                           "20041224,Christmas Eve\n"
+                           "2004-02-30,Invalid\n";
+
+    // Act
+    HolidayImportResult imported = importCsvHolidays(csv, wc);
+    DateTime result = wc.getWorkdayIncrement({Date{year{2004}, May, day{14}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 2u);
+    EXPECT_EQ(imported.recurringHolidays, 1u);
+    EXPECT_EQ(imported.skipped, 2u);
+    EXPECT_EQ(result.date.day(), day{18});
+}
+
+TEST(HolidayImporter, csvLargerThanOneBatch_importsEveryLine)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.buildIndex(Date{year{2029}, January, day{1}}, Date{year{2032}, December, day{31}});
+    std::string csv{};
+    for (sys_days d{Date{year{2030}, January, day{1}}};
+         d < sys_days{Date{year{2031}, July, day{1}}};
+         d += days{1})
+    {
+        Date date{d};
+        csv += std::to_string(static_cast<int>(date.year())) + "-"
+               + std::string(static_cast<unsigned int>(date.month()) < 10 ? "0" : "")
+               + std::to_string(static_cast<unsigned int>(date.month())) + "-"
+               + std::string(static_cast<unsigned int>(date.day()) < 10 ? "0" : "")
+               + std::to_string(static_cast<unsigned int>(date.day())) + "\n";
+    }
+
+    // Act
+    HolidayImportResult imported = importCsvHolidays(csv, wc);
+    DateTime result = wc.getWorkdayIncrement({Date{year{2029}, December, day{31}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(imported.holidays, 546u);
+    EXPECT_EQ(imported.skipped, 0u);
+    EXPECT_EQ(result.date, (Date{year{2031}, July, day{1}}));
+}
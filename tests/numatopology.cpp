@@ -0,0 +1,82 @@
+#include "numatopology.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Unique per test and process, so parallel runs never share or delete each other's tree
+std::filesystem::path makeTemporaryDirectory(void)
+{
+    const testing::TestInfo *test = testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = std::string{"workdaycalendar_"} + test->test_suite_name() + "_"
+                     + test->name() + "_" + std::to_string(getpid());
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void writeFile(const std::filesystem::path &path, const std::string &content)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream{path} << content;
+}
+} // namespace
+
+TEST(NumaTopology, sysfsTree_keepsNodesWithAllowedCpus)
+{
+    // Arrange
+    uint32_t cpu = readNumaTopology().front().cpus.front();
+    std::filesystem::path root = makeTemporaryDirectory();
+    std::filesystem::remove_all(root);
+    writeFile(root / "node1" / "cpulist", std::to_string(cpu) + "-" + std::to_string(cpu) + "\n");
+    writeFile(root / "node3" / "cpulist", "100000-100003\n");
+    writeFile(root / "node4" / "cpulist", "\n");
+    writeFile(root / "possible", "0-4\n");
+
+    // Act
+    std::vector<NumaNode> nodes = readNumaTopology(root.string());
+    std::filesystem::remove_all(root);
+
+    // Assert
+    ASSERT_EQ(nodes.size(), 1u);
+    EXPECT_EQ(nodes[0].id, 1u);
+    EXPECT_EQ(nodes[0].cpus, (std::vector<uint32_t>{cpu}));
+}
+
+TEST(NumaTopology, missingSysfs_isOneNodeWithAllowedCpus)
+{
+    // Arrange
+    std::string root = "/nonexistent/workdaycalendar/node";
+
+    // Act
+    std::vector<NumaNode> nodes = readNumaTopology(root);
+
+    // Assert
+    ASSERT_EQ(nodes.size(), 1u);
+    EXPECT_EQ(nodes[0].id, 0u);
+    EXPECT_FALSE(nodes[0].cpus.empty());
+}
+
+TEST(NumaTopology, emulatedTopology_splitsCpusEvenly)
+{
+    // Arrange
+    std::vector<NumaNode> machine{{.id = 0, .cpus = {0, 1, 2, 3}}, {.id = 1, .cpus = {4, 5, 6, 7}}};
+
+    // Act
+    std::vector<NumaNode> three = emulateNumaTopology(machine, 3);
+    std::vector<NumaNode> tooMany = emulateNumaTopology(machine, 20);
+
+    // Assert
+    ASSERT_EQ(three.size(), 3u);
+    EXPECT_EQ(three[0].cpus, (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(three[1].cpus, (std::vector<uint32_t>{2, 3, 4}));
+    EXPECT_EQ(three[2].cpus, (std::vector<uint32_t>{5, 6, 7}));
+    EXPECT_EQ(tooMany.size(), 8u);
+}
@@ -0,0 +1,64 @@
+#include "parallelworkdaycalendar.h"
+#include "testcalendars.h"
+#include "gtest/gtest.h"
+#include <random>
+
+TEST(ParallelWorkdayCalendar, replicate_independentOfSource)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar source = makeExampleCalendar();
+    source.buildIndex(Date{year{1990}, January, day{1}}, Date{year{2040}, December, day{31}});
+    DateTime start = GregorianCalendar{2004, May, 26, 9, 0}.getDateTime();
+
+    // Act
+    WorkdayCalendar replica = source.replicate();
+    source.removeHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    DateTime fromReplica = replica.getWorkdayIncrement(start, 1.0f);
+    DateTime fromSource = source.getWorkdayIncrement(start, 1.0f);
+
+    // Assert
+    EXPECT_EQ(fromReplica.date, (Date{year{2004}, May, day{28}}));
+    EXPECT_EQ(fromSource.date, (Date{year{2004}, May, day{27}}));
+}
+
+TEST(ParallelWorkdayCalendar, bothPlacements_sameResultsAsCalendar)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar calendar = makeExampleCalendar();
+    calendar.buildIndex(Date{year{1990}, January, day{1}}, Date{year{2040}, December, day{31}});
+    std::vector<NumaNode> topology = emulateNumaTopology(readNumaTopology(), 2);
+    ParallelWorkdayCalendar perNode{calendar, topology, ReplicaPlacement::PerNode};
+    ParallelWorkdayCalendar shared{calendar, topology, ReplicaPlacement::Shared};
+
+    std::mt19937 random{39};
+    std::uniform_int_distribution<PackedDateTime> startDates{
+        packDateTime({Date{year{2000}, January, day{1}}, {}}),
+        packDateTime({Date{year{2030}, December, day{31}}, {}})};
+    std::uniform_real_distribution<float> increments{-50.0f, 50.0f};
+    std::vector<PackedDateTime> starts(10007);
+    std::vector<float> steps(starts.size());
+    for (size_t i = 0; i < starts.size(); ++i)
+    {
+        starts[i] = startDates(random);
+        steps[i] = increments(random);
+    }
+    std::vector<PackedDateTime> expected(starts.size());
+    calendar.getWorkdayIncrements(starts, steps, expected);
+
+    // Act
+    std::vector<PackedDateTime> fromPerNode(starts.size());
+    std::vector<PackedDateTime> fromShared(starts.size());
+    for (int round = 0; round < 3; ++round)
+    {
+        perNode.getWorkdayIncrements(starts, steps, fromPerNode);
+        shared.getWorkdayIncrements(starts, steps, fromShared);
+    }
+
+    // Assert
+    EXPECT_EQ(perNode.getNumberOfReplicas(), topology.size());
+    EXPECT_EQ(shared.getNumberOfReplicas(), 1u);
+    EXPECT_EQ(fromPerNode, expected);
+    EXPECT_EQ(fromShared, expected);
+}
@@ -0,0 +1,108 @@
+#include "queryprotocol.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <limits>
+
+TEST(QueryProtocol, requestFrames_takenWhenCompleteOnly)
+{
+    using namespace std::chrono;
+    // Arrange
+    PackedDateTime start = packDateTime({Date{year{2004}, May, day{24}}, Time{18h + 5min}});
+    QueryRequest first{.requestId = 7,
+                       .calendarId = 1,
+                       .startDate = start,
+                       .incrementWorkdays = -5.5f,
+                       .reserved = 0};
+    QueryRequest second{.requestId = 8,
+                        .calendarId = 2,
+                        .startDate = start,
+                        .incrementWorkdays = 1.0f,
+                        .reserved = 0};
+    std::vector<char> input{};
+    appendFrame(first, input);
+    appendFrame(second, input);
+    input.resize(input.size() - 1); // Last byte of the second request still in flight
+
+    // Act
+    std::vector<QueryRequest> requests = takeFrames<QueryRequest>(input);
+    size_t leftOver = input.size();
+    input.push_back(reinterpret_cast<const char *>(&second)[sizeof(second) - 1]);
+    std::vector<QueryRequest> rest = takeFrames<QueryRequest>(input);
+
+    // Assert
+    ASSERT_EQ(requests.size(), 1u);
+    EXPECT_EQ(requests[0].requestId, 7u);
+    EXPECT_EQ(requests[0].calendarId, 1u);
+    EXPECT_EQ(requests[0].startDate, start);
+    EXPECT_EQ(requests[0].incrementWorkdays, -5.5f);
+    EXPECT_EQ(leftOver, sizeof(QueryRequest) - 1);
+    ASSERT_EQ(rest.size(), 1u);
+    EXPECT_EQ(rest[0].requestId, 8u);
+    EXPECT_TRUE(input.empty());
+}
+
+TEST(QueryProtocol, responseFrame_hasFixedLayout)
+{
+    // Arrange
+    QueryResponse response{.requestId = 42,
+                           .status = QueryStatus::UnknownCalendar,
+                           .result = 17'521'920};
+    std::vector<char> output{};
+
+    // Act
+    appendFrame(response, output);
+    uint32_t requestId = 0;
+    uint32_t status = 0;
+    PackedDateTime result = 0;
+    std::memcpy(&requestId, output.data(), sizeof(requestId));
+    std::memcpy(&status, output.data() + 4, sizeof(status));
+    std::memcpy(&result, output.data() + 8, sizeof(result));
+
+    // Assert
+    ASSERT_EQ(output.size(), 16u);
+    EXPECT_EQ(requestId, 42u);
+    EXPECT_EQ(status, 1u);
+    EXPECT_EQ(result, 17'521'920);
+}
+
+TEST(QueryProtocol, nanOrHugeIncrement_rejectedAsInvalidArgument)
+{
+    using namespace std::chrono;
+    // Arrange
+    PackedDateTime start = packDateTime({Date{year{2004}, May, day{24}}, Time{18h + 5min}});
+    std::vector<char> input{};
+    for (float increment : {std::numeric_limits<float>::quiet_NaN(),
+                            std::numeric_limits<float>::infinity(),
+                            -1.0e9f,
+                            maxIncrementWorkdays,
+                            -5.5f})
+    {
+        appendFrame(QueryRequest{.requestId = static_cast<uint32_t>(input.size()),
+                                 .calendarId = 0,
+                                 .startDate = start,
+                                 .incrementWorkdays = increment,
+                                 .reserved = 0},
+                    input);
+    }
+    QueryRequest unknown{.requestId = 9,
+                         .calendarId = 1,
+                         .startDate = start,
+                         .incrementWorkdays = std::numeric_limits<float>::quiet_NaN(),
+                         .reserved = 0};
+
+    // Act
+    std::vector<QueryStatus> statuses{};
+    for (const QueryRequest &request : takeFrames<QueryRequest>(input))
+    {
+        statuses.push_back(checkRequest(request, 1));
+    }
+
+    // Assert
+    EXPECT_EQ(statuses,
+              (std::vector<QueryStatus>{QueryStatus::InvalidArgument,
+                                        QueryStatus::InvalidArgument,
+                                        QueryStatus::InvalidArgument,
+                                        QueryStatus::Ok,
+                                        QueryStatus::Ok}));
+    EXPECT_EQ(checkRequest(unknown, 1), QueryStatus::UnknownCalendar);
+}
@@ -0,0 +1,133 @@
+#include "slaclock.h"
+#include "testcalendars.h"
+#include "workdaycalendar.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+PackedDateTime makePacked(int d, int hour, int minute)
+{
+    using namespace std::chrono;
+    return packDateTime({Date{year{2004}, May, day{static_cast<unsigned>(d)}},
+                         Time{hours{hour} + minutes{minute}}});
+}
+
+// One minute at a time, straight from the definition
+int64_t countWorkingMinutes(WorkdayCalendar &calendar,
+                            std::span<const WorkingInterval> open,
+                            std::span<const WorkingInterval> paused)
+{
+    auto isInside = [](std::span<const WorkingInterval> intervals, PackedDateTime minute) {
+        return std::any_of(intervals.begin(), intervals.end(), [minute](const auto &interval) {
+            return (interval.start <= minute) && (minute < interval.stop);
+        });
+    };
+    std::vector<uint64_t> workingMask(1);
+
+    int64_t result = 0;
+    for (PackedDateTime minute = makePacked(1, 0, 0); minute < makePacked(31, 0, 0); ++minute)
+    {
+        if (isInside(open, minute) && !isInside(paused, minute))
+        {
+            calendar.classifyWorkingTime({&minute, 1}, workingMask);
+            result += static_cast<int64_t>(workingMask[0] & 1u);
+        }
+    }
+
+    return result;
+}
+} // namespace
+
+TEST(SlaClock, intervalOverWeekendAndHoliday_countsWorkingMinutesOnly)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc = makeExampleCalendar();
+    SlaClock clock = wc.makeSlaClock(Date{year{2004}, January, day{1}},
+                                     Date{year{2004}, December, day{31}});
+
+    // Act
+    minutes overWeekend = clock.getWorkingTime({makePacked(21, 15, 0), makePacked(25, 9, 30)});
+    minutes overHoliday = clock.getWorkingTime({makePacked(26, 12, 0), makePacked(28, 12, 0)});
+    minutes afterHours = clock.getWorkingTime({makePacked(25, 17, 0), makePacked(26, 7, 59)});
+    minutes reversed = clock.getWorkingTime({makePacked(28, 12, 0), makePacked(26, 12, 0)});
+
+    // Assert
+    EXPECT_EQ(overWeekend, minutes{60 + 8 * 60 + 90});
+    EXPECT_EQ(overHoliday, minutes{4 * 60 + 4 * 60});
+    EXPECT_EQ(afterHours, minutes{0});
+    EXPECT_EQ(reversed, minutes{0});
+}
+
+TEST(SlaClock, overlappingIntervalsAndPauses_sameAsMinuteByMinuteCount)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc = makeExampleCalendar();
+    SlaClock clock = wc.makeSlaClock(Date{year{2004}, May, day{1}}, Date{year{2004}, May, day{31}});
+    std::mt19937 random{7};
+    std::uniform_int_distribution<PackedDateTime> starts{makePacked(3, 0, 0), makePacked(26, 0, 0)};
+    std::uniform_int_distribution<PackedDateTime> lengths{-60, 3 * 24 * 60};
+    std::uniform_int_distribution<uint32_t> sizes{0, 4};
+
+    std::vector<WorkingInterval> open{};
+    std::vector<WorkingInterval> paused{};
+    std::vector<uint32_t> openOffsets{0};
+    std::vector<uint32_t> pausedOffsets{0};
+    for (int entity = 0; entity < 20; ++entity)
+    {
+        for (uint32_t i = sizes(random) + 1; i > 0; --i)
+        {
+            PackedDateTime start = starts(random);
+            open.push_back({start, start + lengths(random)});
+        }
+        for (uint32_t i = sizes(random); i > 0; --i)
+        {
+            PackedDateTime start = starts(random);
+            paused.push_back({start, start + lengths(random) / 4});
+        }
+        openOffsets.push_back(static_cast<uint32_t>(open.size()));
+        pausedOffsets.push_back(static_cast<uint32_t>(paused.size()));
+    }
+    std::vector<minutes> results(openOffsets.size() - 1);
+
+    // Act
+    clock.getWorkingTimes(open, openOffsets, paused, pausedOffsets, results);
+
+    // Assert
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        std::span<const WorkingInterval> entityOpen{open.begin() + openOffsets[i],
+                                                    open.begin() + openOffsets[i + 1]};
+        std::span<const WorkingInterval> entityPaused{paused.begin() + pausedOffsets[i],
+                                                      paused.begin() + pausedOffsets[i + 1]};
+        EXPECT_EQ(results[i].count(), countWorkingMinutes(wc, entityOpen, entityPaused)) << i;
+        EXPECT_EQ(results[i], clock.getWorkingTime(entityOpen, entityPaused)) << i;
+    }
+}
+
+TEST(SlaClock, inconsistentOffsets_throwInvalidArgument)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc = makeExampleCalendar();
+    SlaClock clock = wc.makeSlaClock(Date{year{2004}, May, day{1}}, Date{year{2004}, May, day{31}});
+    std::vector<WorkingInterval> open{{makePacked(3, 9, 0), makePacked(3, 10, 0)},
+                                      {makePacked(4, 9, 0), makePacked(4, 10, 0)}};
+    std::vector<uint32_t> offsets{0, 1, 2};
+    std::vector<uint32_t> noPauses{0, 0, 0};
+    std::vector<uint32_t> descending{0, 2, 1};
+    std::vector<uint32_t> pastTheEnd{0, 1, 3};
+    std::vector<minutes> results(2);
+
+    // Act & Assert
+    EXPECT_THROW(clock.getWorkingTimes(open, descending, {}, noPauses, results),
+                 std::invalid_argument);
+    EXPECT_THROW(clock.getWorkingTimes(open, pastTheEnd, {}, noPauses, results),
+                 std::invalid_argument);
+    EXPECT_THROW(clock.getWorkingTimes(open, offsets, {}, offsets, results), std::invalid_argument);
+    clock.getWorkingTimes(open, offsets, {}, noPauses, results);
+    EXPECT_EQ(results, (std::vector<minutes>{minutes{60}, minutes{60}}));
+}
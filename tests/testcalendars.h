@@ -0,0 +1,14 @@
+#pragma once
+#include "workdaycalendar.h"
+
+// Calendar of the README example: 08:00-16:00, May 17 every year and May 27 2004 off
+inline WorkdayCalendar makeExampleCalendar(void)
+{
+    using namespace std::chrono;
+    WorkdayCalendar result{};
+    result.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                                  GregorianCalendar{2004, January, 1, 16, 0});
+    result.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+    result.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    return result;
+}
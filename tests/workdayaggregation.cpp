@@ -0,0 +1,118 @@
+#include "workdayaggregation.h"
+#include "gtest/gtest.h"
+
+TEST(WorkdayAggregation, monthWithHolidays_countsWorkdaysAndWorkingTime)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                              GregorianCalendar{2004, January, 1, 16, 0});
+    wc.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+    wc.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+
+    // Act
+    auto result = aggregateWorkload(wc,
+                                    Date{year{2004}, May, day{1}},
+                                    Date{year{2004}, May, day{31}},
+                                    AggregationPeriod::PerMonth);
+
+    // Assert
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].periodStart, (Date{year{2004}, May, day{1}}));
+    EXPECT_EQ(result[0].workdays, 19u);
+    EXPECT_EQ(result[0].workingTime, hours{19 * 8});
+}
+
+TEST(WorkdayAggregation, yearByQuarter_recurringHolidayCountedEveryYear)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0}); // Wednesday in 2023
+
+    // Act
+    auto result = aggregateWorkload(wc,
+                                    Date{year{2023}, January, day{1}},
+                                    Date{year{2023}, December, day{31}},
+                                    AggregationPeriod::PerQuarter);
+
+    // Assert
+    ASSERT_EQ(result.size(), 4u);
+    EXPECT_EQ(result[0].workdays, 65u);
+    EXPECT_EQ(result[1].workdays, 64u);
+    EXPECT_EQ(result[1].periodStart, (Date{year{2023}, April, day{1}}));
+    EXPECT_EQ(result[2].workdays, 65u);
+    EXPECT_EQ(result[3].workdays, 65u);
+}
+
+TEST(WorkdayAggregation, weeksNotAlignedWithRange_firstBucketIsClipped)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+
+    // Act: Wednesday 10th to Sunday 21st of December 2025
+    auto result = aggregateWorkload(wc,
+                                    Date{year{2025}, December, day{10}},
+                                    Date{year{2025}, December, day{21}},
+                                    AggregationPeriod::PerWeek);
+
+    // Assert
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].periodStart, (Date{year{2025}, December, day{10}}));
+    EXPECT_EQ(result[0].workdays, 3u);
+    EXPECT_EQ(result[1].periodStart, (Date{year{2025}, December, day{15}}));
+    EXPECT_EQ(result[1].workdays, 5u);
+}
+
+TEST(WorkdayAggregation, manyCalendars_oneResultPerCalendar)
+{
+    using namespace std::chrono;
+    // Arrange
+    std::vector<WorkdayCalendar> calendars(3);
+    calendars[1].setHoliday(GregorianCalendar{2021, January, 4, 0, 0});
+    calendars[2].setRecurringHoliday(GregorianCalendar{2000, January, 5, 0, 0});
+    calendars[2].setRecurringHoliday(GregorianCalendar{2000, January, 6, 0, 0});
+
+    // Act
+    auto result = aggregateWorkload(calendars,
+                                    Date{year{2021}, January, day{1}},
+                                    Date{year{2021}, March, day{31}},
+                                    AggregationPeriod::PerMonth);
+
+    // Assert
+    ASSERT_EQ(result.size(), 3u);
+    for (const auto &perCalendar : result)
+    {
+        ASSERT_EQ(perCalendar.size(), 3u);
+        EXPECT_EQ(perCalendar[1].workdays, 20u);
+    }
+    EXPECT_EQ(result[0][0].workdays, 21u);
+    EXPECT_EQ(result[1][0].workdays, 20u);
+    EXPECT_EQ(result[2][0].workdays, 19u);
+}
+
+TEST(WorkdayBitmap, countAcrossWords_matchesDayByDayCount)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setHoliday(GregorianCalendar{2024, February, 29, 0, 0});
+    WorkdayBitmap bitmap
+        = wc.compile(Date{year{2024}, January, day{1}}, Date{year{2024}, December, day{31}});
+    sys_days from{Date{year{2024}, January, day{17}}};
+    sys_days to{Date{year{2024}, October, day{2}}};
+
+    // Act
+    uint32_t result = bitmap.countWorkdays(from, to);
+
+    // Assert
+    uint32_t expected = 0;
+    for (sys_days d = from; d <= to; d += days{1})
+    {
+        expected += bitmap.isWorkday(d) ? 1u : 0u;
+    }
+    EXPECT_EQ(result, expected);
+    EXPECT_FALSE(bitmap.isWorkday(sys_days{Date{year{2024}, February, day{29}}}));
+}
@@ -380,3 +380,157 @@ INSTANTIATE_TEST_SUITE_P(
                     KataScenario{-6.7470217f, 18, 3, 2004, std::chrono::May, 13, 10, 1},
                     KataScenario{12.782709f, 8, 3, 2004, std::chrono::June, 10, 14, 18},
                     KataScenario{8.276628f, 7, 3, 2004, std::chrono::June, 4, 10, 12}));
+
+TEST(WorkdayCalendar, packedDateTime_roundTrips)
+{
+    using namespace std::chrono;
+    // Arrange
+    DateTime dt = GregorianCalendar(1969, December, 31, 23, 59).getDateTime();
+
+    // Act
+    PackedDateTime packed = packDateTime(dt);
+    DateTime result = unpackDateTime(packed);
+
+    // Assert
+    EXPECT_EQ(packed, -1);
+    EXPECT_EQ(result.date, dt.date);
+    EXPECT_EQ(result.time.to_duration(), dt.time.to_duration());
+}
+
+TEST(WorkdayCalendar, batchIncrement_sameResultAsSingleIncrement)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                              GregorianCalendar{2004, January, 1, 16, 0});
+    wc.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+    wc.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+
+    std::vector<PackedDateTime> starts{
+        packDateTime(GregorianCalendar(2004, May, 24, 18, 5).getDateTime()),
+        packDateTime(GregorianCalendar(2004, May, 24, 19, 3).getDateTime()),
+        packDateTime(GregorianCalendar(2004, May, 24, 8, 3).getDateTime())};
+    std::vector<float> increments{-5.5f, 44.723656f, 12.782709f};
+    std::vector<PackedDateTime> results(starts.size());
+
+    // Act
+    wc.getWorkdayIncrements(starts, increments, results);
+
+    // Assert
+    for (size_t i = 0; i < starts.size(); ++i)
+    {
+        DateTime expected = wc.getWorkdayIncrement(unpackDateTime(starts[i]), increments[i]);
+        EXPECT_EQ(results[i], packDateTime(expected));
+    }
+}
+
+TEST(WorkdayCalendar, holidayFreeCalendar_sameResultAsDayWalk)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar holidayFree{};
+    holidayFree.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                                       GregorianCalendar{2004, January, 1, 16, 0});
+    WorkdayCalendar walked = holidayFree;
+    walked.setHoliday(GregorianCalendar{1800, January, 1, 0, 0}); // Never reached
+
+    // Act & Assert: every weekday of two weeks, whole and partial days both ways
+    for (int offset = 0; offset < 14; ++offset)
+    {
+        for (float increment : {0.0f, 1.0f, -1.0f, 4.0f, -4.0f, 5.0f, -5.0f, 13.0f, -13.0f,
+                                0.25f, -0.25f, 7.6f, -7.6f, 250.5f, -250.5f})
+        {
+            for (int hour : {6, 12, 18})
+            {
+                Date date{sys_days{Date{year{2025}, December, day{1}}} + days{offset}};
+                DateTime start{date, Time{hours{hour}}};
+
+                DateTime expected = walked.getWorkdayIncrement(start, increment);
+                DateTime result = holidayFree.getWorkdayIncrement(start, increment);
+
+                ASSERT_EQ(result.date, expected.date) << offset << " " << increment;
+                ASSERT_EQ(result.time.to_duration(), expected.time.to_duration());
+            }
+        }
+    }
+}
+
+TEST(WorkdayCalendar, sortedBatchSweep_sameResultAsUnsortedBatch)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                              GregorianCalendar{2004, January, 1, 16, 0});
+    wc.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+    wc.setRecurringHoliday(GregorianCalendar{2004, December, 25, 0, 0});
+    wc.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+
+    std::vector<PackedDateTime> starts{};
+    std::vector<float> increments{};
+    PackedDateTime first = packDateTime({Date{year{2004}, January, day{1}}, {}});
+    for (int i = 0; i < 2000; ++i)
+    {
+        starts.push_back(first + static_cast<PackedDateTime>(i) * 571);
+        increments.push_back(static_cast<float>((i * 37) % 121 - 60) + ((i % 3) ? 0.0f : 0.4f));
+    }
+    std::vector<PackedDateTime> expected(starts.size());
+    std::vector<PackedDateTime> swept(starts.size());
+    std::vector<PackedDateTime> sweptWithIndex(starts.size());
+
+    // Act
+    wc.getWorkdayIncrements(starts, increments, expected, BatchOrder::Unsorted);
+    wc.getWorkdayIncrements(starts, increments, swept, BatchOrder::Sorted);
+    wc.buildIndex(Date{year{2003}, January, day{1}}, Date{year{2007}, December, day{31}});
+    wc.getWorkdayIncrements(starts, increments, sweptWithIndex);
+
+    // Assert
+    EXPECT_EQ(swept, expected);
+    EXPECT_EQ(sweptWithIndex, expected);
+}
+
+TEST(WorkdayCalendar, sortedBatchSpanningCenturies_sameResultAsUnsortedBatch)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+    wc.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    std::vector<PackedDateTime> starts{packDateTime({Date{year{1604}, May, day{14}}, {}}),
+                                       packDateTime({Date{year{2004}, May, day{24}}, {}}),
+                                       packDateTime({Date{year{2904}, May, day{14}}, {}})};
+    std::vector<float> increments{3.0f, 4.0f, 3.0f};
+    std::vector<PackedDateTime> expected(starts.size());
+    std::vector<PackedDateTime> results(starts.size());
+
+    // Act
+    wc.getWorkdayIncrements(starts, increments, expected, BatchOrder::Unsorted);
+    wc.getWorkdayIncrements(starts, increments, results, BatchOrder::Sorted);
+
+    // Assert
+    EXPECT_EQ(results, expected);
+    EXPECT_EQ(unpackDateTime(results[1]).date, (Date{year{2004}, May, day{31}}));
+}
+
+TEST(WorkdayCalendar, declaredSortedButUnsorted_stillCorrect)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setHoliday(GregorianCalendar{2021, January, 6, 0, 0});
+    std::vector<PackedDateTime> starts{packDateTime({Date{year{2021}, January, day{4}}, {}}),
+                                       packDateTime({Date{year{2020}, January, day{4}}, {}}),
+                                       packDateTime({Date{year{2021}, January, day{5}}, {}})};
+    std::vector<float> increments{2.0f, -300.0f, 1.0f};
+    std::vector<PackedDateTime> expected(starts.size());
+    std::vector<PackedDateTime> results(starts.size());
+
+    // Act
+    wc.getWorkdayIncrements(starts, increments, expected, BatchOrder::Unsorted);
+    wc.getWorkdayIncrements(starts, increments, results, BatchOrder::Sorted);
+
+    // Assert
+    EXPECT_EQ(results, expected);
+    EXPECT_EQ(unpackDateTime(results[0]).date, (Date{year{2021}, January, day{7}}));
+}
@@ -0,0 +1,170 @@
+#include "workdaycalendar.h"
+#include "workdaycalendarc.h"
+#include "gtest/gtest.h"
+#include <limits>
+#include <memory>
+
+namespace
+{
+using CalendarPointer = std::unique_ptr<WorkdayCalendarHandle, void (*)(WorkdayCalendarHandle *)>;
+
+CalendarPointer makeCalendar(void)
+{
+    return {workdayCalendarCreate(), workdayCalendarDestroy};
+}
+
+int32_t toDays(Date date)
+{
+    return static_cast<int32_t>(std::chrono::sys_days{date}.time_since_epoch().count());
+}
+} // namespace
+
+TEST(WorkdayCalendarC, frozenCalendar_inPlaceIncrementsMatchCppCalendar)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar reference{};
+    reference.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                                     GregorianCalendar{2004, January, 1, 16, 0});
+    reference.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    reference.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+
+    CalendarPointer calendar = makeCalendar();
+    int32_t holidays[] = {toDays(Date{year{2004}, May, day{27}})};
+    int32_t recurring[] = {toDays(Date{year{1990}, May, day{17}})};
+    ASSERT_TRUE(calendar);
+    ASSERT_EQ(workdayCalendarSetWorkingHours(calendar.get(), 8 * 60, 16 * 60), WorkdayCalendarOk);
+    ASSERT_EQ(workdayCalendarAddHolidays(calendar.get(), holidays, 1), WorkdayCalendarOk);
+    ASSERT_EQ(workdayCalendarAddRecurringHolidays(calendar.get(), recurring, 1), WorkdayCalendarOk);
+    ASSERT_EQ(workdayCalendarFreeze(calendar.get(), 2000, 2010), WorkdayCalendarOk);
+
+    std::vector<int64_t> timestamps{};
+    std::vector<float> increments{};
+    for (int i = 0; i < 200; ++i)
+    {
+        DateTime start = GregorianCalendar(2004, May, 24, 19, 3).getDateTime();
+        start.date = Date{sys_days{start.date} + days{(i * 37) % 400}};
+        timestamps.push_back(packDateTime(start));
+        increments.push_back(static_cast<float>(i % 41) * 0.75f - 15.0f);
+    }
+    std::vector<int64_t> expected(timestamps.size());
+    reference.getWorkdayIncrements(timestamps, increments, expected);
+
+    // Act
+    WorkdayCalendarStatus status = workdayCalendarIncrements(
+        calendar.get(), timestamps.data(), increments.data(), timestamps.data(), timestamps.size());
+    WorkdayCalendarStatus change = workdayCalendarAddHolidays(calendar.get(), holidays, 1);
+
+    // Assert
+    EXPECT_EQ(status, WorkdayCalendarOk);
+    EXPECT_EQ(timestamps, expected);
+    EXPECT_EQ(change, WorkdayCalendarFrozen);
+}
+
+TEST(WorkdayCalendarC, invalidArguments_rejectedWithoutSideEffects)
+{
+    // Arrange
+    CalendarPointer calendar = makeCalendar();
+    int64_t timestamps[1] = {};
+    float increments[1] = {};
+
+    // Act & Assert
+    EXPECT_EQ(workdayCalendarAbiVersion(), uint32_t{WORKDAYCALENDAR_C_ABI_VERSION});
+    EXPECT_EQ(workdayCalendarSetWorkingHours(nullptr, 0, 60), WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarSetWorkingHours(calendar.get(), 600, 480),
+              WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarSetWorkingHours(calendar.get(), 0, 1440),
+              WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarAddHolidays(calendar.get(), nullptr, 3),
+              WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarAddHolidays(calendar.get(), nullptr, 0), WorkdayCalendarOk);
+    EXPECT_EQ(workdayCalendarIncrements(calendar.get(), timestamps, nullptr, timestamps, 1),
+              WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarIncrements(nullptr, timestamps, increments, timestamps, 1),
+              WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarFreeze(calendar.get(), 2010, 2000), WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(workdayCalendarFreeze(calendar.get(), 2000, 2010), WorkdayCalendarOk);
+    EXPECT_EQ(workdayCalendarFreeze(calendar.get(), 2000, 2010), WorkdayCalendarFrozen);
+}
+
+TEST(WorkdayCalendarC, utcIncrementsAndClassification_useCallerBuffers)
+{
+    using namespace std::chrono;
+    // Arrange
+    CalendarPointer calendar = makeCalendar();
+    int64_t transitions[] = {packDateTime({Date{year{2024}, March, day{31}}, Time{hours{1}}})};
+    int32_t offsets[] = {120};
+    ASSERT_EQ(workdayCalendarSetWorkingHours(calendar.get(), 8 * 60, 16 * 60), WorkdayCalendarOk);
+    ASSERT_EQ(workdayCalendarSetTimeZone(calendar.get(), 60, transitions, offsets, 1),
+              WorkdayCalendarOk);
+    ASSERT_EQ(workdayCalendarFreeze(calendar.get(), 2024, 2024), WorkdayCalendarOk);
+    int64_t timestamps[] = {packDateTime({Date{year{2024}, March, day{29}}, Time{hours{14}}}),
+                            packDateTime({Date{year{2024}, March, day{30}}, Time{hours{10}}})};
+    float increments[] = {0.25f, 0.0f};
+    int64_t results[2] = {};
+    uint64_t workingMask[1] = {};
+
+    // Act
+    WorkdayCalendarStatus incremented
+        = workdayCalendarUtcIncrements(calendar.get(), timestamps, increments, results, 2);
+    WorkdayCalendarStatus classified
+        = workdayCalendarClassifyWorkingTime(calendar.get(), timestamps, workingMask, 2);
+
+    // Assert
+    EXPECT_EQ(incremented, WorkdayCalendarOk);
+    EXPECT_EQ(results[0], packDateTime({Date{year{2024}, April, day{1}}, Time{hours{7}}}));
+    EXPECT_EQ(classified, WorkdayCalendarOk);
+    EXPECT_EQ(workingMask[0], 0b01u);
+}
+
+TEST(WorkdayCalendarC, oversizedCount_reportedWithoutThrowing)
+{
+    // Arrange
+    CalendarPointer calendar = makeCalendar();
+    int32_t holidays[1] = {};
+    int64_t transitions[1] = {};
+    int32_t offsets[1] = {};
+    size_t count = std::numeric_limits<size_t>::max() / 2;
+
+    // Act
+    WorkdayCalendarStatus added = workdayCalendarAddHolidays(calendar.get(), holidays, count);
+    WorkdayCalendarStatus zoned
+        = workdayCalendarSetTimeZone(calendar.get(), 0, transitions, offsets, count);
+
+    // Assert
+    EXPECT_EQ(added, WorkdayCalendarInternalError);
+    EXPECT_EQ(zoned, WorkdayCalendarInternalError);
+    EXPECT_EQ(workdayCalendarFreeze(calendar.get(), 2000, 2010), WorkdayCalendarOk);
+}
+
+TEST(WorkdayCalendarC, nanOrHugeIncrement_rejectedWithoutTouchingResults)
+{
+    using namespace std::chrono;
+    // Arrange
+    CalendarPointer calendar = makeCalendar();
+    ASSERT_EQ(workdayCalendarFreeze(calendar.get(), 2000, 2010), WorkdayCalendarOk);
+    int64_t timestamps[] = {packDateTime({Date{year{2004}, May, day{24}}, Time{hours{9}}}),
+                            packDateTime({Date{year{2004}, May, day{25}}, Time{hours{9}}})};
+    float missing[] = {1.0f, std::numeric_limits<float>::quiet_NaN()};
+    float huge[] = {-2.0f * WORKDAYCALENDAR_C_MAX_INCREMENT_WORKDAYS, 1.0f};
+    float largest[] = {WORKDAYCALENDAR_C_MAX_INCREMENT_WORKDAYS, 1.0f};
+    int64_t results[2] = {-1, -1};
+
+    // Act
+    WorkdayCalendarStatus nan
+        = workdayCalendarIncrements(calendar.get(), timestamps, missing, results, 2);
+    WorkdayCalendarStatus utcNan
+        = workdayCalendarUtcIncrements(calendar.get(), timestamps, missing, results, 2);
+    WorkdayCalendarStatus tooLarge
+        = workdayCalendarIncrements(calendar.get(), timestamps, huge, results, 2);
+    int64_t untouched = results[0];
+    WorkdayCalendarStatus atBound
+        = workdayCalendarIncrements(calendar.get(), timestamps, largest, results, 2);
+
+    // Assert
+    EXPECT_EQ(nan, WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(utcNan, WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(tooLarge, WorkdayCalendarInvalidArgument);
+    EXPECT_EQ(untouched, -1);
+    EXPECT_EQ(atBound, WorkdayCalendarOk);
+}
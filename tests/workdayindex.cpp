@@ -0,0 +1,146 @@
+#include "workdaycalendar.h"
+#include "workdayindex.h"
+#include "gtest/gtest.h"
+
+TEST(WorkdayIndex, toggleDays_countMatchesBitmap)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    WorkdayIndex index{
+        wc.compile(Date{year{2020}, January, day{1}}, Date{year{2029}, December, day{31}})};
+    sys_days from{Date{year{2021}, March, day{3}}};
+    sys_days to{Date{year{2027}, August, day{30}}};
+    uint32_t before = index.countWorkdays(from, to);
+
+    // Act
+    index.setWorkday(sys_days{Date{year{2022}, June, day{1}}}, false);  // Wednesday
+    index.setWorkday(sys_days{Date{year{2022}, June, day{1}}}, false);  // No double count
+    index.setWorkday(sys_days{Date{year{2025}, December, day{6}}}, true); // Saturday
+
+    // Assert
+    EXPECT_EQ(index.countWorkdays(from, to), before);
+    EXPECT_EQ(index.countWorkdays(from, to), index.getBitmap().countWorkdays(from, to));
+    EXPECT_FALSE(index.isWorkday(sys_days{Date{year{2022}, June, day{1}}}));
+}
+
+TEST(WorkdayIndex, findWorkday_forwardAndBackwardThroughWeekend)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    WorkdayIndex index{
+        wc.compile(Date{year{2025}, January, day{1}}, Date{year{2025}, December, day{31}})};
+    sys_days friday{Date{year{2025}, December, day{5}}};
+
+    // Act
+    auto forward = index.findWorkday(friday, 1);
+    auto backward = index.findWorkday(sys_days{Date{year{2025}, December, day{8}}}, -1);
+    auto same = index.findWorkday(friday, 0);
+    auto outOfRange = index.findWorkday(friday, 30);
+
+    // Assert
+    ASSERT_TRUE(forward.has_value());
+    EXPECT_EQ(Date{*forward}, (Date{year{2025}, December, day{8}}));
+    ASSERT_TRUE(backward.has_value());
+    EXPECT_EQ(*backward, friday);
+    ASSERT_TRUE(same.has_value());
+    EXPECT_EQ(*same, friday);
+    EXPECT_FALSE(outOfRange.has_value());
+}
+
+TEST(WorkdayIndex, holidayAddedAndRemovedAfterBuild_indexFollows)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.buildIndex(Date{year{2004}, January, day{1}}, Date{year{2004}, December, day{31}});
+    DateTime dt = {Date{year{2004}, May, day{26}}, {}};
+
+    // Act
+    wc.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    DateTime withHoliday = wc.getWorkdayIncrement(dt, 1.0f);
+    wc.removeHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    DateTime withoutHoliday = wc.getWorkdayIncrement(dt, 1.0f);
+
+    // Assert
+    EXPECT_EQ(withHoliday.date.day(), day{28});
+    EXPECT_EQ(withoutHoliday.date.day(), day{27});
+}
+
+TEST(WorkdayIndex, recurringHolidayRemoved_freesEveryIndexedYear)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setRecurringHoliday(GregorianCalendar{2000, May, 17, 0, 0});
+    wc.buildIndex(Date{year{2020}, January, day{1}}, Date{year{2025}, December, day{31}});
+
+    // Act
+    DateTime withHoliday = wc.getWorkdayIncrement({Date{year{2023}, May, day{16}}, {}}, 1.0f);
+    wc.removeRecurringHoliday(GregorianCalendar{2000, May, 17, 0, 0});
+    DateTime withoutHoliday = wc.getWorkdayIncrement({Date{year{2023}, May, day{16}}, {}}, 1.0f);
+
+    // Assert
+    EXPECT_EQ(withHoliday.date.day(), day{18});
+    EXPECT_EQ(withoutHoliday.date.day(), day{17});
+}
+
+TEST(WorkdayIndex, incrementLeavesIndexedRange_fallsBackToDayWalk)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.buildIndex(Date{year{2021}, January, day{1}}, Date{year{2021}, January, day{31}});
+    DateTime dt = {Date{year{2021}, January, day{4}}, {}};
+
+    // Act
+    DateTime result = wc.getWorkdayIncrement(dt, 20.0f);
+
+    // Assert
+    EXPECT_EQ(result.date.day(), day{1});
+    EXPECT_EQ(result.date.month(), February);
+}
+
+struct IndexedKataScenario
+{
+    float incrementWorkdays;
+    uint8_t startHour, startMinute;
+};
+
+class WorkdayIndexKata : public testing::TestWithParam<IndexedKataScenario>
+{
+};
+
+TEST_P(WorkdayIndexKata, scenarios_sameResultAsDayWalk)
+{
+    using namespace std::chrono;
+    // Arrange
+    auto [increment, sh, sm] = GetParam();
+
+    WorkdayCalendar walked{};
+    walked.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                                  GregorianCalendar{2004, January, 1, 16, 0});
+    walked.setRecurringHoliday(GregorianCalendar{2004, May, 17, 0, 0});
+    walked.setHoliday(GregorianCalendar{2004, May, 27, 0, 0});
+    WorkdayCalendar indexed = walked;
+    indexed.buildIndex(Date{year{2003}, January, day{1}}, Date{year{2005}, December, day{31}});
+
+    // Act
+    DateTime start = GregorianCalendar(2004, May, 24, sh, sm).getDateTime();
+    DateTime expected = walked.getWorkdayIncrement(start, increment);
+    DateTime result = indexed.getWorkdayIncrement(start, increment);
+
+    // Assert
+    EXPECT_EQ(result.date, expected.date);
+    EXPECT_EQ(result.time.to_duration(), expected.time.to_duration());
+}
+
+INSTANTIATE_TEST_SUITE_P(KataScenarios,
+                         WorkdayIndexKata,
+                         testing::Values(IndexedKataScenario{-5.5f, 18, 5},
+                                         IndexedKataScenario{44.723656f, 19, 3},
+                                         IndexedKataScenario{-6.7470217f, 18, 3},
+                                         IndexedKataScenario{12.782709f, 8, 3},
+                                         IndexedKataScenario{8.276628f, 7, 3},
+                                         IndexedKataScenario{-200.25f, 12, 0}));
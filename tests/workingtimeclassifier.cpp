@@ -0,0 +1,101 @@
+#include "workdaycalendar.h"
+#include "workingtimeclassifier.h"
+#include "gtest/gtest.h"
+#include <limits>
+#include <random>
+
+TEST(WorkingTimeClassifier, boundariesAndWeekend_flaggedAsExpected)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                              GregorianCalendar{2004, January, 1, 16, 0});
+    wc.setHoliday(GregorianCalendar{2025, December, 10, 0, 0});
+    std::vector<PackedDateTime> timestamps{
+        packDateTime(GregorianCalendar(2025, December, 9, 7, 59).getDateTime()),
+        packDateTime(GregorianCalendar(2025, December, 9, 8, 0).getDateTime()),
+        packDateTime(GregorianCalendar(2025, December, 9, 15, 59).getDateTime()),
+        packDateTime(GregorianCalendar(2025, December, 9, 16, 0).getDateTime()),
+        packDateTime(GregorianCalendar(2025, December, 10, 12, 0).getDateTime()), // Holiday
+        packDateTime(GregorianCalendar(2025, December, 13, 12, 0).getDateTime()), // Saturday
+        packDateTime(GregorianCalendar(2025, December, 15, 12, 0).getDateTime())};
+    std::vector<uint64_t> mask(1);
+
+    // Act
+    wc.classifyWorkingTime(timestamps, mask);
+
+    // Assert
+    EXPECT_EQ(mask[0], 0b1000110u);
+}
+
+TEST(WorkingTimeClassifier, randomTimestamps_vectorAndScalarAgree)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 9, 30},
+                              GregorianCalendar{2004, January, 1, 17, 15});
+    wc.setRecurringHoliday(GregorianCalendar{2000, May, 17, 0, 0});
+    WorkdayBitmap bitmap
+        = wc.compile(Date{year{1969}, June, day{1}}, Date{year{1975}, December, day{31}});
+
+    std::mt19937 random{42};
+    std::uniform_int_distribution<PackedDateTime> minutesAround{-400000, 3500000};
+    std::vector<PackedDateTime> timestamps(1001);
+    for (PackedDateTime &timestamp : timestamps)
+    {
+        timestamp = minutesAround(random);
+    }
+    std::vector<uint64_t> mask((timestamps.size() + 63) / 64, ~uint64_t{0});
+
+    // Act
+    classifyWorkingTime(bitmap,
+                        Time{hours{9} + minutes{30}},
+                        Time{hours{17} + minutes{15}},
+                        timestamps,
+                        mask);
+
+    // Assert
+    for (size_t i = 0; i < timestamps.size(); ++i)
+    {
+        sys_time<minutes> tp{minutes{timestamps[i]}};
+        sys_days d = floor<days>(tp);
+        minutes minute = tp - d;
+        bool expected = bitmap.contains(d) && bitmap.isWorkday(d) && (minute >= minutes{570})
+                        && (minute < minutes{1035});
+        ASSERT_EQ(((mask[i / 64] >> (i % 64)) & 1u) != 0, expected) << i;
+    }
+}
+
+TEST(WorkingTimeClassifier, extremeTimestamps_neitherWidenBitmapNorBreakVectorPath)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2004, January, 1, 8, 0},
+                              GregorianCalendar{2004, January, 1, 16, 0});
+    wc.setRecurringHoliday(GregorianCalendar{2000, May, 17, 0, 0});
+    PackedDateTime monday
+        = packDateTime(GregorianCalendar(2025, December, 15, 12, 0).getDateTime());
+    std::vector<PackedDateTime> timestamps{
+        monday,
+        std::numeric_limits<PackedDateTime>::max(),
+        monday,
+        monday,
+        std::numeric_limits<PackedDateTime>::min(),
+        (PackedDateTime{1} << 51) + monday, // Past the exact range of the double conversion
+        monday,
+        monday,
+        packDateTime(GregorianCalendar(2525, May, 14, 9, 0).getDateTime()),    // Far-off Monday
+        packDateTime(GregorianCalendar(2525, May, 17, 9, 0).getDateTime()),    // Far-off holiday
+        packDateTime(GregorianCalendar(1650, March, 1, 15, 59).getDateTime()), // Far-off Tuesday
+        monday};
+    std::vector<uint64_t> mask(1);
+
+    // Act
+    wc.classifyWorkingTime(timestamps, mask);
+
+    // Assert
+    EXPECT_EQ(mask[0], 0b1101'1100'1101u);
+}
@@ -0,0 +1,105 @@
+#include "workdaycalendar.h"
+#include "zonetransitiontable.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+PackedDateTime makePacked(std::chrono::year_month_day date, int hour, int minute)
+{
+    return packDateTime({date, Time{std::chrono::hours{hour} + std::chrono::minutes{minute}}});
+}
+
+// Europe/Berlin around 2024: CET (+1h), CEST (+2h) from 31 March, CET again from 27 October
+ZoneTransitionTable makeBerlin2024(void)
+{
+    using namespace std::chrono;
+    std::vector<OffsetTransition> transitions{
+        {.utc = makePacked(Date{year{2024}, October, day{27}}, 1, 0), .offset = minutes{60}},
+        {.utc = makePacked(Date{year{2024}, March, day{31}}, 1, 0), .offset = minutes{120}}};
+    return ZoneTransitionTable{minutes{60}, transitions};
+}
+} // namespace
+
+TEST(ZoneTransitionTable, aroundTransitions_convertsBothWays)
+{
+    using namespace std::chrono;
+    // Arrange
+    ZoneTransitionTable berlin = makeBerlin2024();
+    Date spring{year{2024}, March, day{31}};
+    Date autumn{year{2024}, October, day{27}};
+
+    // Act & Assert
+    EXPECT_EQ(berlin.toLocal(makePacked(spring, 0, 59)), makePacked(spring, 1, 59));
+    EXPECT_EQ(berlin.toLocal(makePacked(spring, 1, 0)), makePacked(spring, 3, 0));
+    EXPECT_EQ(berlin.toUtc(makePacked(spring, 3, 0)), makePacked(spring, 1, 0));
+    EXPECT_EQ(berlin.toUtc(makePacked(spring, 12, 0)), makePacked(spring, 10, 0));
+    EXPECT_EQ(berlin.toLocal(makePacked(autumn, 0, 30)), makePacked(autumn, 2, 30));
+    EXPECT_EQ(berlin.toLocal(makePacked(autumn, 1, 30)), makePacked(autumn, 2, 30));
+    EXPECT_EQ(berlin.toUtc(makePacked(autumn, 3, 0)), makePacked(autumn, 2, 0));
+    EXPECT_EQ(berlin.getOffset(makePacked(Date{year{2030}, July, day{1}}, 0, 0)), minutes{60});
+}
+
+TEST(ZoneTransitionTable, skippedAndRepeatedLocalTimes_resolveForwardAndEarliest)
+{
+    using namespace std::chrono;
+    // Arrange
+    ZoneTransitionTable berlin = makeBerlin2024();
+    Date spring{year{2024}, March, day{31}};
+    Date autumn{year{2024}, October, day{27}};
+
+    // Act
+    PackedDateTime skipped = berlin.toUtc(makePacked(spring, 2, 30));
+    PackedDateTime repeated = berlin.toUtc(makePacked(autumn, 2, 30));
+
+    // Assert
+    EXPECT_EQ(berlin.toLocal(skipped), makePacked(spring, 3, 30));
+    EXPECT_EQ(repeated, makePacked(autumn, 0, 30));
+}
+
+TEST(ZoneTransitionTable, utcIncrementAcrossSpringForward_usesLocalWorkingHours)
+{
+    using namespace std::chrono;
+    // Arrange
+    WorkdayCalendar wc{};
+    wc.setWorkdayStartAndStop(GregorianCalendar{2024, January, 1, 8, 0},
+                              GregorianCalendar{2024, January, 1, 16, 0});
+    wc.setTimeZone(std::make_shared<const ZoneTransitionTable>(makeBerlin2024()));
+    std::vector<PackedDateTime> starts{makePacked(Date{year{2024}, March, day{29}}, 14, 0),
+                                       makePacked(Date{year{2024}, April, day{2}}, 6, 0)};
+    std::vector<float> increments{0.25f, -1.0f};
+    std::vector<PackedDateTime> results(starts.size());
+
+    // Act
+    PackedDateTime single = wc.getUtcWorkdayIncrement(starts[0], increments[0]);
+    wc.getUtcWorkdayIncrements(starts, increments, results);
+
+    // Assert
+    // Friday 15:00 CET plus two hours ends Monday 09:00 CEST, which is 07:00 UTC
+    EXPECT_EQ(single, makePacked(Date{year{2024}, April, day{1}}, 7, 0));
+    EXPECT_EQ(results[0], single);
+    // Tuesday 08:00 CEST minus one day is Monday 08:00 CEST
+    EXPECT_EQ(results[1], makePacked(Date{year{2024}, April, day{1}}, 6, 0));
+}
+
+#ifdef WORKDAYCALENDAR_HAS_TZDB
+TEST(ZoneTransitionTable, tzdbZone_matchesTimeZoneLookups)
+{
+    using namespace std::chrono;
+    // Arrange
+    const time_zone *zone = locate_zone("Europe/Berlin");
+    std::shared_ptr<const ZoneTransitionTable> table
+        = getZoneTransitionTable("Europe/Berlin", year{2000}, year{2030});
+
+    // Act & Assert
+    ASSERT_TRUE(table);
+    EXPECT_EQ(table, getZoneTransitionTable("Europe/Berlin", year{2000}, year{2030}));
+    EXPECT_FALSE(getZoneTransitionTable("Nowhere/Atlantis", year{2000}, year{2030}));
+    for (sys_minutes utc = sys_days{Date{year{2000}, January, day{1}}};
+         utc < sys_days{Date{year{2030}, December, day{31}}};
+         utc += hours{997})
+    {
+        PackedDateTime expected = zone->to_local(utc).time_since_epoch().count();
+        EXPECT_EQ(table->toLocal(utc.time_since_epoch().count()), expected);
+    }
+}
+#endif